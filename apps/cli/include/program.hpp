@@ -1,10 +1,15 @@
 #pragma once
 
+#include <span>
+
 namespace conch::cli {
 
 class Program {
   public:
     static auto interactive() -> void;
+
+    // Parses and dumps each source file, returning a failing exit code if any of them had errors.
+    static auto files(std::span<const char* const> paths) -> int;
 };
 
 } // namespace conch::cli
@@ -1,3 +1,11 @@
+#include <span>
+
 #include "program.hpp"
 
-auto main() -> int { conch::cli::Program::interactive(); }
+auto main(int argc, char* argv[]) -> int {
+    if (argc < 2) {
+        conch::cli::Program::interactive();
+        return 0;
+    }
+    return conch::cli::Program::files(std::span{argv + 1, static_cast<std::size_t>(argc - 1)});
+}
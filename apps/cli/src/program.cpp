@@ -1,3 +1,5 @@
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <string>
 
@@ -11,10 +13,23 @@
 #include "ast/ast.hpp"
 #include "ast/dumper.hpp"
 
+#include "source_file.hpp"
 #include "string.hpp"
 
 namespace conch::cli {
 
+// Prints the errors if there are any and dumps the AST otherwise, returning true on success.
+static auto report(const ast::AST& ast, const Parser::Diagnostics& errors) -> bool {
+    if (!errors.empty()) {
+        fmt::println("{}", errors);
+        return false;
+    }
+
+    ast::ASTDumper dumper{std::cout};
+    for (const auto& node : ast) { node->accept(dumper); }
+    return true;
+}
+
 auto Program::interactive() -> void {
     Parser p;
 
@@ -29,13 +44,29 @@ auto Program::interactive() -> void {
 
         p.reset(trimmed);
         auto [ast, errors] = p.consume();
-        if (!errors.empty()) {
-            fmt::println("{}", errors);
-        } else {
-            ast::ASTDumper dumper{std::cout};
-            for (const auto& node : ast) { node->accept(dumper); }
+        report(ast, errors);
+    }
+}
+
+auto Program::files(std::span<const char* const> paths) -> int {
+    Parser p;
+    auto   status = EXIT_SUCCESS;
+
+    for (const auto* path : paths) {
+        // Declared before the AST so the mapping outlives every view the AST holds into it
+        const auto source = SourceFile::open(path);
+        if (!source) {
+            fmt::println(stderr, "{}", source.error());
+            status = EXIT_FAILURE;
+            continue;
         }
+
+        p.reset(source->view());
+        auto [ast, errors] = p.consume();
+        if (!report(ast, errors)) { status = EXIT_FAILURE; }
     }
+
+    return status;
 }
 
 } // namespace conch::cli
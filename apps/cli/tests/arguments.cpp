@@ -1,7 +1,75 @@
+#include <array>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
 #include <catch2/catch_test_macros.hpp>
 
+#include "program.hpp"
+
+#include "source_file.hpp"
+
 namespace conch::tests {
 
-TEST_CASE("Trivial") { REQUIRE(1 == 1); }
+// Writes a file to the temporary directory, removing it however the test using it exits.
+struct TempFile {
+    std::filesystem::path path;
+    std::string           name;
+
+    TempFile(std::string_view filename, std::string_view contents)
+        : path{std::filesystem::temp_directory_path() / filename}, name{path.string()} {
+        std::ofstream stream{path, std::ios::binary};
+        stream << contents;
+    }
+
+    TempFile(const TempFile&)                    = delete;
+    auto operator=(const TempFile&) -> TempFile& = delete;
+
+    ~TempFile() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+};
+
+TEST_CASE("Files that parse") {
+    const TempFile file{"conch_cli_valid.conch",
+                        "const a := 1;\nvar b := fn(x: int): int { return x * a; };\n"};
+    const std::array paths{file.name.c_str()};
+    REQUIRE(cli::Program::files(paths) == EXIT_SUCCESS);
+}
+
+TEST_CASE("Missing files") {
+    const auto missing =
+        (std::filesystem::temp_directory_path() / "conch_cli_missing.conch").string();
+    std::filesystem::remove(missing);
+
+    const std::array paths{missing.c_str()};
+    REQUIRE(cli::Program::files(paths) == EXIT_FAILURE);
+
+    // Every other file is still parsed, but the run fails
+    const TempFile   file{"conch_cli_present.conch", "const a := 1;"};
+    const std::array mixed{file.name.c_str(), missing.c_str()};
+    REQUIRE(cli::Program::files(mixed) == EXIT_FAILURE);
+}
+
+#if !defined(_WIN32)
+TEST_CASE("Files too large to parse") {
+    // The file is left sparse, so its size is never actually written
+    const TempFile file{"conch_cli_large.conch", ""};
+    std::filesystem::resize_file(file.path, SourceFile::MAX_SIZE + 1);
+
+    const std::array paths{file.name.c_str()};
+    REQUIRE(cli::Program::files(paths) == EXIT_FAILURE);
+}
+#endif
+
+TEST_CASE("Files with parse errors") {
+    const TempFile   file{"conch_cli_invalid.conch", "const a := ;"};
+    const std::array paths{file.name.c_str()};
+    REQUIRE(cli::Program::files(paths) == EXIT_FAILURE);
+}
 
 } // namespace conch::tests
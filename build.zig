@@ -172,6 +172,15 @@ const TestArtifacts = struct {
             runner.step.dependOn(b.getInstallStep());
             test_step.dependOn(&runner.step);
         }
+
+        // Benchmarks are hidden test cases so they never slow down the regular test steps. Use
+        // `zig build bench --release` to run them.
+        const bench_runner = b.addRunArtifact(self.compiler_tests);
+        bench_runner.addArg("[benchmark]");
+        bench_runner.step.dependOn(b.getInstallStep());
+
+        const bench_step = b.step("bench", "Run compiler microbenchmarks");
+        bench_step.dependOn(&bench_runner.step);
     }
 };
 
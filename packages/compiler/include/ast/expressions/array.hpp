@@ -1,13 +1,14 @@
 #pragma once
 
 #include <span>
-#include <vector>
 
 #include "ast/expressions/type.hpp"
 #include "ast/node.hpp"
 
 #include "parser/parser.hpp"
 
+#include "arena.hpp"
+
 namespace conch::ast {
 
 class ArrayExpression : public ExprBase<ArrayExpression> {
@@ -18,7 +19,7 @@ class ArrayExpression : public ExprBase<ArrayExpression> {
     explicit ArrayExpression(const Token&                 start_token,
                              Optional<Box<Expression>>    size,
                              ExplicitType&&               item_type,
-                             std::vector<Box<Expression>> items) noexcept;
+                             ArenaVector<Box<Expression>> items) noexcept;
     ~ArrayExpression() override;
 
     MAKE_AST_COPY_MOVE(ArrayExpression)
@@ -36,7 +37,7 @@ class ArrayExpression : public ExprBase<ArrayExpression> {
   private:
     Optional<Box<Expression>>    size_;
     ExplicitType                 item_type_;
-    std::vector<Box<Expression>> items_;
+    ArenaVector<Box<Expression>> items_;
 };
 
 } // namespace conch::ast
@@ -1,13 +1,13 @@
 #pragma once
 
 #include <span>
-#include <vector>
 
 #include "ast/expressions/type.hpp"
 #include "ast/node.hpp"
 
 #include "parser/parser.hpp"
 
+#include "arena.hpp"
 #include "variant.hpp"
 
 namespace conch::ast {
@@ -36,7 +36,7 @@ class CallExpression : public ExprBase<CallExpression> {
   public:
     explicit CallExpression(const Token&              start_token,
                             Box<Expression>           function,
-                            std::vector<CallArgument> arguments) noexcept;
+                            ArenaVector<CallArgument> arguments) noexcept;
     ~CallExpression() override;
 
     MAKE_AST_COPY_MOVE(CallExpression)
@@ -53,7 +53,7 @@ class CallExpression : public ExprBase<CallExpression> {
 
   private:
     Box<Expression>           function_;
-    std::vector<CallArgument> arguments_;
+    ArenaVector<CallArgument> arguments_;
 };
 
 } // namespace conch::ast
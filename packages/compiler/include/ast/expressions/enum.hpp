@@ -6,6 +6,8 @@
 
 #include "parser/parser.hpp"
 
+#include "arena.hpp"
+
 namespace conch::ast {
 
 class IdentifierExpression;
@@ -34,7 +36,7 @@ class EnumExpression : public ExprBase<EnumExpression> {
   public:
     explicit EnumExpression(const Token&                        start_token,
                             Optional<Box<IdentifierExpression>> underlying,
-                            std::vector<Enumeration>            enumerations) noexcept;
+                            ArenaVector<Enumeration>            enumerations) noexcept;
     ~EnumExpression() override;
 
     MAKE_AST_COPY_MOVE(EnumExpression)
@@ -50,7 +52,7 @@ class EnumExpression : public ExprBase<EnumExpression> {
 
   private:
     Optional<Box<IdentifierExpression>> underlying_;
-    std::vector<Enumeration>            enumerations_;
+    ArenaVector<Enumeration>            enumerations_;
 };
 
 } // namespace conch::ast
@@ -1,13 +1,13 @@
 #pragma once
 
 #include <span>
-#include <vector>
 
 #include "ast/expressions/type_modifiers.hpp"
 #include "ast/node.hpp"
 
 #include "parser/parser.hpp"
 
+#include "arena.hpp"
 #include "variant.hpp"
 
 namespace conch::ast {
@@ -58,8 +58,8 @@ class ForLoopExpression : public ExprBase<ForLoopExpression> {
 
   public:
     explicit ForLoopExpression(const Token&                 start_token,
-                               std::vector<Box<Expression>> iterables,
-                               std::vector<ForLoopCapture>  captures,
+                               ArenaVector<Box<Expression>> iterables,
+                               ArenaVector<ForLoopCapture>  captures,
                                Box<BlockStatement>          block,
                                Optional<Box<Statement>>     non_break) noexcept;
     ~ForLoopExpression() override;
@@ -78,8 +78,8 @@ class ForLoopExpression : public ExprBase<ForLoopExpression> {
     auto is_equal(const Node& other) const noexcept -> bool override;
 
   private:
-    std::vector<Box<Expression>> iterables_;
-    std::vector<ForLoopCapture>  captures_;
+    ArenaVector<Box<Expression>> iterables_;
+    ArenaVector<ForLoopCapture>  captures_;
     Box<BlockStatement>          block_;
     Optional<Box<Statement>>     non_break_;
 };
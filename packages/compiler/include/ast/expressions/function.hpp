@@ -1,12 +1,15 @@
 #pragma once
 
 #include <span>
+#include <variant>
 
 #include "ast/expressions/type.hpp"
 #include "ast/node.hpp"
 
 #include "parser/parser.hpp"
 
+#include "arena.hpp"
+
 namespace conch::ast {
 
 class IdentifierExpression;
@@ -54,9 +57,16 @@ class FunctionExpression : public ExprBase<FunctionExpression> {
   public:
     explicit FunctionExpression(const Token&                   start_token,
                                 Optional<SelfParameter>        self,
-                                std::vector<FunctionParameter> parameters,
+                                ArenaVector<FunctionParameter> parameters,
                                 ExplicitType&&                 return_type,
                                 Optional<Box<BlockStatement>>  body) noexcept;
+
+    // Creates a function whose body is parsed the first time it is read.
+    explicit FunctionExpression(const Token&                   start_token,
+                                Optional<SelfParameter>        self,
+                                ArenaVector<FunctionParameter> parameters,
+                                ExplicitType&&                 return_type,
+                                DeferredRange                  body) noexcept;
     ~FunctionExpression() override;
 
     MAKE_AST_COPY_MOVE(FunctionExpression)
@@ -67,16 +77,33 @@ class FunctionExpression : public ExprBase<FunctionExpression> {
     MAKE_OPTIONAL_UNPACKER(self, SelfParameter, self_, *)
     MAKE_AST_GETTER(parameters, std::span<const FunctionParameter>, )
     MAKE_AST_GETTER(return_type, const ExplicitType&, )
-    MAKE_OPTIONAL_UNPACKER(body, BlockStatement, body_, **)
+
+    // The parsed body, which a deferred body only has once load_body has succeeded.
+    [[nodiscard]] auto get_body() const noexcept -> const BlockStatement&;
+    [[nodiscard]] auto has_body() const noexcept -> bool {
+        return body_.has_value() || body_range_.source;
+    }
+
+    [[nodiscard]] auto is_body_deferred() const noexcept -> bool { return body_range_.source; }
+
+    // Parses a deferred body if it has not been parsed yet, returning why it failed otherwise.
+    // Failed parses are kept deferred and retried on each call. This writes to the node and its
+    // tree's arena, so like the rest of the tree it is not thread-safe.
+    [[nodiscard]] auto load_body() const -> Expected<std::monostate, ParserDiagnostic>;
 
   protected:
     auto is_equal(const Node& other) const noexcept -> bool override;
 
   private:
-    Optional<SelfParameter>        self_;
-    std::vector<FunctionParameter> parameters_;
-    ExplicitType                   return_type_;
-    Optional<Box<BlockStatement>>  body_;
+    auto bodies_equal(const FunctionExpression& other) const noexcept -> bool;
+
+    Optional<SelfParameter>               self_;
+    ArenaVector<FunctionParameter>        parameters_;
+    ExplicitType                          return_type_;
+    mutable Optional<Box<BlockStatement>> body_;
+    mutable DeferredRange                 body_range_;
+
+    friend class TokenShifter;
 };
 
 } // namespace conch::ast
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <utility>
 
 #include "ast/node.hpp"
@@ -7,6 +8,10 @@
 
 #include "parser/parser.hpp"
 
+#include "arena.hpp"
+#include "optional.hpp"
+#include "types.hpp"
+
 namespace conch::ast {
 
 template <typename Derived> class InfixExpression : public ExprBase<Derived> {
@@ -33,7 +38,17 @@ template <typename Derived> class InfixExpression : public ExprBase<Derived> {
 
         parser.advance();
         auto rhs = TRY(parser.parse_expression(current_precedence));
-        return make_box<Derived>(lhs->get_token(), std::move(lhs), op_token.type, std::move(rhs));
+        return Derived::make(parser, std::move(lhs), op_token.type, std::move(rhs));
+    }
+
+    // Joins operands that were parsed separately, so the expression loop can fold nested operators
+    // off of the call stack.
+    [[nodiscard]] static auto make(Parser&        parser,
+                                   Box<Expression> lhs,
+                                   TokenType       op,
+                                   Box<Expression> rhs) -> Box<Expression> {
+        const auto start_token = lhs->get_token();
+        return parser.make_box<Derived>(start_token, std::move(lhs), op, std::move(rhs));
     }
 
   protected:
@@ -61,11 +76,95 @@ template <typename Derived> class InfixExpression : public ExprBase<Derived> {
     };
 
 DECLARE_INFIX_EXPRESSION(AssignmentExpression, NodeKind::ASSIGNMENT_EXPRESSION)
-DECLARE_INFIX_EXPRESSION(BinaryExpression, NodeKind::BINARY_EXPRESSION)
 DECLARE_INFIX_EXPRESSION(DotExpression, NodeKind::DOT_EXPRESSION)
 DECLARE_INFIX_EXPRESSION(RangeExpression, NodeKind::RANGE_EXPRESSION)
 DECLARE_INFIX_EXPRESSION(ImplicitDereferenceExpression, NodeKind::IMPLICIT_DEREFERENCE_EXPRESSION)
 
 #undef DECLARE_INFIX_EXPRESSION
 
+class BinaryExpression : public InfixExpression<BinaryExpression> {
+  public:
+    static constexpr auto KIND = NodeKind::BINARY_EXPRESSION;
+
+  public:
+    using InfixExpression::InfixExpression;
+    MAKE_AST_COPY_MOVE(BinaryExpression)
+
+    using InfixExpression::parse;
+
+    // Extends runs of the same operator into a chain when the parser flattens them.
+    [[nodiscard]] static auto make(Parser&        parser,
+                                   Box<Expression> lhs,
+                                   TokenType       op,
+                                   Box<Expression> rhs) -> Box<Expression>;
+
+    friend class BinaryChainExpression;
+};
+
+class BinaryChainExpression;
+
+// One binary of the left-deep spine a chain stands for. Only the innermost binary has its left
+// operand in the chain, every other one takes the binary before it.
+struct BinaryLink {
+    Optional<const Expression&> lhs;
+    TokenType                   op;
+    const Expression&           rhs;
+};
+
+// The left-deep binaries a chain stands for, read off of its operands without building them. It
+// borrows the chain, so it is only valid as long as the chain is.
+class BinarySpine {
+  public:
+    explicit BinarySpine(const BinaryChainExpression& chain) noexcept : chain_{chain} {}
+
+    [[nodiscard]] auto size() const noexcept -> usize;
+
+    // The binary at the index, counting outwards from the innermost one.
+    [[nodiscard]] auto operator[](usize idx) const noexcept -> BinaryLink;
+
+    // Whether a tree of binaries is this spine, as the parser builds it without flattening.
+    [[nodiscard]] auto matches(const Expression& binaries) const noexcept -> bool;
+
+  private:
+    const BinaryChainExpression& chain_;
+};
+
+// A run of one left associative binary operator, such as `a + b + c + d`, stored as a single
+// operand list instead of a left-deep spine of binaries. Produced only when
+// `ParserOptions::flatten_binary_chains` is set and the run has at least three operands.
+class BinaryChainExpression : public ExprBase<BinaryChainExpression> {
+  public:
+    static constexpr auto KIND = NodeKind::BINARY_CHAIN_EXPRESSION;
+
+  public:
+    explicit BinaryChainExpression(const Token&                 start_token,
+                                   TokenType                    op,
+                                   ArenaVector<Box<Expression>> operands) noexcept;
+    ~BinaryChainExpression() override;
+
+    MAKE_AST_COPY_MOVE(BinaryChainExpression)
+
+    auto accept(Visitor& v) const -> void override;
+
+    // Folds `lhs op rhs` into the chain on the left, or starts a chain from a binary of the same
+    // operator. Anything else is returned as a plain binary.
+    [[nodiscard]] static auto extend(Parser&         parser,
+                                     Box<Expression> lhs,
+                                     TokenType       op,
+                                     Box<Expression> rhs) -> Box<Expression>;
+
+    // Presents the chain as the left-deep binaries it replaces for passes that expect them.
+    [[nodiscard]] auto as_binaries() const noexcept -> BinarySpine { return BinarySpine{*this}; }
+
+    MAKE_AST_GETTER(op, TokenType, )
+    MAKE_AST_GETTER(operands, std::span<const Box<Expression>>, )
+
+  protected:
+    auto is_equal(const Node& other) const noexcept -> bool override;
+
+  private:
+    TokenType                    op_;
+    ArenaVector<Box<Expression>> operands_;
+};
+
 } // namespace conch::ast
@@ -7,6 +7,7 @@
 
 #include "parser/parser.hpp"
 
+#include "arena.hpp"
 #include "variant.hpp"
 
 namespace conch::ast {
@@ -51,7 +52,7 @@ class MatchExpression : public ExprBase<MatchExpression> {
   public:
     explicit MatchExpression(const Token&             start_token,
                              Box<Expression>          matcher,
-                             std::vector<MatchArm>    arms,
+                             ArenaVector<MatchArm>    arms,
                              Optional<Box<Statement>> catch_all) noexcept;
     ~MatchExpression() override;
 
@@ -69,7 +70,7 @@ class MatchExpression : public ExprBase<MatchExpression> {
 
   private:
     Box<Expression>          matcher_;
-    std::vector<MatchArm>    arms_;
+    ArenaVector<MatchArm>    arms_;
     Optional<Box<Statement>> catch_all_;
 };
 
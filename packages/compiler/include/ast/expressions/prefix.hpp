@@ -24,7 +24,13 @@ template <typename Derived> class PrefixExpression : public ExprBase<Derived> {
         parser.advance();
 
         auto operand = TRY(parser.parse_expression(Precedence::PREFIX));
-        return make_box<Derived>(prefix_token, std::move(operand));
+        return make(parser, prefix_token, std::move(operand));
+    }
+
+    // Wraps an operand that was parsed separately, so the expression loop can fold unary chains.
+    [[nodiscard]] static auto make(Parser& parser, const Token& prefix_token, Box<Expression> rhs)
+        -> Box<Expression> {
+        return parser.make_box<Derived>(prefix_token, std::move(rhs));
     }
 
     [[nodiscard]] auto get_op() const noexcept -> TokenType { return this->start_token_.type; }
@@ -2,7 +2,9 @@
 
 #include <cassert>
 #include <charconv>
+#include <limits>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include <fmt/format.h>
@@ -33,7 +35,19 @@ template <typename Derived, typename T> class PrimitiveExpression : public ExprB
         requires(!disable_default_parse<Derived>::value)
     {
         const auto start_token = parser.current_token();
-        const auto base        = token_type::to_base(start_token.type);
+        if constexpr (std::is_integral_v<value_type>) {
+            // Integers are normally decoded by the lexer, so the digits need not be scanned again
+            if (const auto literal = parser.integer_value(start_token)) {
+                if (literal->overflow ||
+                    literal->value > static_cast<u64>(std::numeric_limits<value_type>::max())) {
+                    return make_parser_unexpected(ParserError::INTEGER_OVERFLOW, start_token);
+                }
+                return parser.make_box<Derived>(start_token,
+                                                static_cast<value_type>(literal->value));
+            }
+        }
+
+        const auto base = token_type::to_base(start_token.type);
 
         const auto* first = start_token.slice.cbegin() + (!base || *base == Base::DECIMAL ? 0 : 2);
         const auto* last  = start_token.slice.cend() - token_type::suffix_length(start_token.type);
@@ -46,7 +60,7 @@ template <typename Derived, typename T> class PrimitiveExpression : public ExprB
             result = std::from_chars(first, last, v, std::to_underlying(*base));
         }
         if (result.ec == std::errc{} && result.ptr == last) {
-            return make_box<Derived>(start_token, v);
+            return parser.make_box<Derived>(start_token, v);
         }
 
         assert(result.ec == std::errc::result_out_of_range);
@@ -70,7 +84,8 @@ template <typename Derived, typename T> class PrimitiveExpression : public ExprB
     value_type value_;
 };
 
-class StringExpression : public PrimitiveExpression<StringExpression, std::string> {
+// A string literal whose value views either the source itself or the parser's literal pool.
+class StringExpression : public PrimitiveExpression<StringExpression, std::string_view> {
   public:
     static constexpr auto KIND = NodeKind::STRING_EXPRESSION;
 
@@ -6,6 +6,8 @@
 
 #include "parser/parser.hpp"
 
+#include "arena.hpp"
+
 namespace conch::ast {
 
 class FunctionExpression;
@@ -17,7 +19,7 @@ class StructExpression : public ExprBase<StructExpression> {
 
   public:
     explicit StructExpression(const Token&                    start_token,
-                              std::vector<Box<DeclStatement>> members) noexcept;
+                              ArenaVector<Box<DeclStatement>> members) noexcept;
     ~StructExpression() override;
 
     MAKE_AST_COPY_MOVE(StructExpression)
@@ -34,7 +36,7 @@ class StructExpression : public ExprBase<StructExpression> {
     auto is_equal(const Node& other) const noexcept -> bool override;
 
   private:
-    std::vector<Box<DeclStatement>> members_;
+    ArenaVector<Box<DeclStatement>> members_;
 };
 
 } // namespace conch::ast
@@ -63,6 +63,10 @@ class ExplicitType {
 
     MAKE_AST_DEPENDENT_EQ(ExplicitType)
 
+  private:
+    [[nodiscard]] static auto parse_unmemoized(Parser& parser)
+        -> Expected<ExplicitType, ParserDiagnostic>;
+
   private:
     TypeModifier        modifier_;
     ExplicitTypeVariant type_;
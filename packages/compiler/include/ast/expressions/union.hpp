@@ -1,13 +1,14 @@
 #pragma once
 
 #include <span>
-#include <vector>
 
 #include "ast/expressions/type.hpp"
 #include "ast/node.hpp"
 
 #include "parser/parser.hpp"
 
+#include "arena.hpp"
+
 namespace conch::ast {
 
 class IdentifierExpression;
@@ -34,7 +35,7 @@ class UnionExpression : public ExprBase<UnionExpression> {
     static constexpr auto KIND = NodeKind::UNION_EXPRESSION;
 
   public:
-    explicit UnionExpression(const Token& start_token, std::vector<UnionField> fields) noexcept;
+    explicit UnionExpression(const Token& start_token, ArenaVector<UnionField> fields) noexcept;
     ~UnionExpression() override;
 
     MAKE_AST_COPY_MOVE(UnionExpression)
@@ -48,7 +49,7 @@ class UnionExpression : public ExprBase<UnionExpression> {
     auto is_equal(const Node& other) const noexcept -> bool override;
 
   private:
-    std::vector<UnionField> fields_;
+    ArenaVector<UnionField> fields_;
 };
 
 } // namespace conch::ast
@@ -0,0 +1,716 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ast/node.hpp"
+
+#include "ast/expressions/primitive.hpp"
+#include "ast/expressions/type_modifiers.hpp"
+#include "ast/statements/declaration.hpp"
+
+#include "lexer/token.hpp"
+#include "lexer/token_buffer.hpp"
+
+#include "parser/parser.hpp"
+
+#include "types.hpp"
+
+namespace conch::ast {
+
+// A data-oriented encoding of a parsed tree in the style of Zig's Ast.
+//
+// Each node is a NodeKind tag, the index of its start token and a pair of u32 operands, all kept
+// in parallel arrays. Nodes with more than two operands point at a range of the extra data array
+// instead, which also holds the records for non-node pieces like explicit types and call
+// arguments. Those arrays are plain integers, but the token buffer views the source the tree was
+// lowered from through a string_view, so the source has to outlive the tree.
+//
+// The views in the `flat` namespace mirror the getters of the pointer AST on top of this layout.
+class FlatAST {
+  public:
+    using Index = u32;
+
+    // Marks an absent child, record or token.
+    static constexpr Index NONE = std::numeric_limits<Index>::max();
+
+    using Data = std::array<Index, 2>;
+
+  public:
+    FlatAST() noexcept = default;
+
+    // Lowers a finished pointer tree without recursing, resolving each node's start token against
+    // the stream it was parsed from. Strings are copied into the flat tree, but token slices still
+    // view the source.
+    //
+    // Deferred bodies are loaded along the way. One that fails to parse is lowered as if the
+    // function had no body, and its error is returned alongside the tree.
+    [[nodiscard]] static auto lower(const AST&             ast,
+                                    std::string_view       source,
+                                    std::span<const Token> tokens)
+        -> std::pair<FlatAST, std::vector<ParserDiagnostic>>;
+
+    [[nodiscard]] auto size() const noexcept -> usize { return kinds_.size(); }
+    [[nodiscard]] auto empty() const noexcept -> bool { return kinds_.empty(); }
+
+    [[nodiscard]] auto kind(Index node) const noexcept -> NodeKind { return kinds_[node]; }
+    [[nodiscard]] auto main_token(Index node) const noexcept -> Index {
+        return main_tokens_[node];
+    }
+    [[nodiscard]] auto data(Index node) const noexcept -> const Data& { return data_[node]; }
+    [[nodiscard]] auto token(Index node) const -> Token { return tokens_[main_tokens_[node]]; }
+
+    [[nodiscard]] auto kinds() const noexcept -> std::span<const NodeKind> { return kinds_; }
+    [[nodiscard]] auto main_tokens() const noexcept -> std::span<const Index> {
+        return main_tokens_;
+    }
+    [[nodiscard]] auto extra() const noexcept -> std::span<const Index> { return extra_; }
+    [[nodiscard]] auto roots() const noexcept -> std::span<const Index> { return roots_; }
+    [[nodiscard]] auto tokens() const noexcept -> const TokenBuffer& { return tokens_; }
+
+    // The payload of a string literal, which may have been materialized from escapes.
+    [[nodiscard]] auto string(Index offset, Index length) const noexcept -> std::string_view {
+        return std::string_view{strings_}.substr(offset, length);
+    }
+
+    // Returns the operands of a node that keeps them in the extra data array.
+    [[nodiscard]] auto operands(Index node) const noexcept -> std::span<const Index> {
+        const auto& [from, to] = data_[node];
+        return std::span{extra_}.subspan(from, to - from);
+    }
+
+    template <typename View> [[nodiscard]] auto view(Index node) const -> View {
+        assert(kinds_[node] == View::KIND);
+        return View{*this, node};
+    }
+
+  private:
+    std::vector<NodeKind> kinds_;
+    std::vector<Index>    main_tokens_;
+    std::vector<Data>     data_;
+    std::vector<Index>    extra_;
+    std::vector<Index>    roots_;
+    std::string           strings_;
+    TokenBuffer           tokens_;
+
+    friend class FlatLowering;
+};
+
+namespace flat {
+
+using Index                 = FlatAST::Index;
+inline constexpr Index NONE = FlatAST::NONE;
+
+// Type modifiers are stored as zero for value types and one past the modifier otherwise.
+[[nodiscard]] inline auto decode_modifier(Index encoded) -> TypeModifier {
+    if (encoded == 0) { return TypeModifier{nullopt}; }
+    return TypeModifier{static_cast<TypeModifier::Modifier>(encoded - 1)};
+}
+
+// Primitive values are stored as the low and high halves of their 64-bit representation.
+template <typename T> [[nodiscard]] constexpr auto encode_value(T value) noexcept -> u64 {
+    if constexpr (std::same_as<T, f64>) {
+        return std::bit_cast<u64>(value);
+    } else if constexpr (std::same_as<T, f32>) {
+        return std::bit_cast<u32>(value);
+    } else {
+        return static_cast<u64>(value);
+    }
+}
+
+template <typename T> [[nodiscard]] constexpr auto decode_value(u64 bits) noexcept -> T {
+    if constexpr (std::same_as<T, f64>) {
+        return std::bit_cast<f64>(bits);
+    } else if constexpr (std::same_as<T, f32>) {
+        return std::bit_cast<f32>(static_cast<u32>(bits));
+    } else {
+        return static_cast<T>(bits);
+    }
+}
+
+// A handle to a node or record in a flat tree.
+class View {
+  public:
+    View(const FlatAST& ast, Index idx) noexcept : ast_{&ast}, idx_{idx} {}
+
+    [[nodiscard]] auto ast() const noexcept -> const FlatAST& { return *ast_; }
+    [[nodiscard]] auto index() const noexcept -> Index { return idx_; }
+
+  protected:
+    [[nodiscard]] auto operand(usize slot) const noexcept -> Index {
+        return ast_->operands(idx_)[slot];
+    }
+    [[nodiscard]] auto inline_operand(usize slot) const noexcept -> Index {
+        return ast_->data(idx_)[slot];
+    }
+    [[nodiscard]] auto record(usize slot) const noexcept -> Index {
+        return ast_->extra()[idx_ + slot];
+    }
+
+  protected:
+    const FlatAST* ast_;
+    Index          idx_;
+};
+
+class NodeView : public View {
+  public:
+    using View::View;
+
+    [[nodiscard]] auto get_kind() const noexcept -> NodeKind { return ast_->kind(idx_); }
+    [[nodiscard]] auto get_token() const -> Token { return ast_->token(idx_); }
+};
+
+// A list of fixed width records stored back to back in the extra data array.
+template <typename Record> class Records {
+  public:
+    class Iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Record;
+        using difference_type   = std::ptrdiff_t;
+
+      public:
+        Iterator() noexcept = default;
+        Iterator(const FlatAST& ast, Index at) noexcept : ast_{&ast}, at_{at} {}
+
+        auto operator*() const noexcept -> Record { return Record{*ast_, at_}; }
+        auto operator++() noexcept -> Iterator& {
+            at_ += Record::WIDTH;
+            return *this;
+        }
+        auto operator++(int) noexcept -> Iterator {
+            auto copy = *this;
+            at_ += Record::WIDTH;
+            return copy;
+        }
+
+        auto operator==(const Iterator& other) const noexcept -> bool { return at_ == other.at_; }
+
+      private:
+        const FlatAST* ast_{nullptr};
+        Index          at_{0};
+    };
+
+  public:
+    Records(const FlatAST& ast, Index first, usize count) noexcept
+        : ast_{&ast}, first_{first}, count_{count} {}
+
+    [[nodiscard]] auto size() const noexcept -> usize { return count_; }
+    [[nodiscard]] auto empty() const noexcept -> bool { return count_ == 0; }
+    [[nodiscard]] auto operator[](usize i) const noexcept -> Record {
+        return Record{*ast_, first_ + static_cast<Index>(i * Record::WIDTH)};
+    }
+
+    [[nodiscard]] auto begin() const noexcept -> Iterator { return Iterator{*ast_, first_}; }
+    [[nodiscard]] auto end() const noexcept -> Iterator {
+        return Iterator{*ast_, first_ + static_cast<Index>(count_ * Record::WIDTH)};
+    }
+
+  private:
+    const FlatAST* ast_;
+    Index          first_;
+    usize          count_;
+};
+
+// Records, indexed into the extra data array.
+
+class ExplicitType : public View {
+  public:
+    static constexpr usize WIDTH = 4;
+
+    enum class Variant : Index {
+        IDENT,
+        FUNCTION,
+        ARRAY,
+        RECURSIVE,
+    };
+
+  public:
+    using View::View;
+
+    [[nodiscard]] auto get_modifier() const -> TypeModifier { return decode_modifier(record(0)); }
+    [[nodiscard]] auto get_variant() const noexcept -> Variant {
+        return static_cast<Variant>(record(1));
+    }
+
+    [[nodiscard]] auto is_ident_type() const noexcept -> bool {
+        return get_variant() == Variant::IDENT;
+    }
+    [[nodiscard]] auto is_function_type() const noexcept -> bool {
+        return get_variant() == Variant::FUNCTION;
+    }
+    [[nodiscard]] auto is_array_type() const noexcept -> bool {
+        return get_variant() == Variant::ARRAY;
+    }
+    [[nodiscard]] auto is_recursive_type() const noexcept -> bool {
+        return get_variant() == Variant::RECURSIVE;
+    }
+
+    // The identifier or function node of the matching variants.
+    [[nodiscard]] auto get_node() const noexcept -> Index { return record(2); }
+
+    // The dimension of an array type, or NONE for slices.
+    [[nodiscard]] auto get_dimension() const noexcept -> Index { return record(2); }
+    [[nodiscard]] auto has_dimension() const noexcept -> bool { return record(2) != NONE; }
+
+    // The element type of an array or the wrapped type of a recursive type.
+    [[nodiscard]] auto get_inner_type() const noexcept -> ExplicitType {
+        return ExplicitType{*ast_, is_array_type() ? record(3) : record(2)};
+    }
+};
+
+class CallArgument : public View {
+  public:
+    static constexpr usize WIDTH = 2;
+
+  public:
+    using View::View;
+
+    [[nodiscard]] auto is_type() const noexcept -> bool { return record(0) != 0; }
+    [[nodiscard]] auto is_expression() const noexcept -> bool { return record(0) == 0; }
+    [[nodiscard]] auto get_expression() const noexcept -> Index { return record(1); }
+    [[nodiscard]] auto get_type() const noexcept -> ExplicitType {
+        return ExplicitType{*ast_, record(1)};
+    }
+};
+
+class Enumeration : public View {
+  public:
+    static constexpr usize WIDTH = 2;
+
+  public:
+    using View::View;
+
+    [[nodiscard]] auto get_ident() const noexcept -> Index { return record(0); }
+    [[nodiscard]] auto has_default_value() const noexcept -> bool { return record(1) != NONE; }
+    [[nodiscard]] auto get_default_value() const noexcept -> Index { return record(1); }
+};
+
+class ForLoopCapture : public View {
+  public:
+    static constexpr usize WIDTH = 2;
+
+  public:
+    using View::View;
+
+    [[nodiscard]] auto is_discarded() const noexcept -> bool { return record(1) == NONE; }
+    [[nodiscard]] auto get_modifier() const -> TypeModifier { return decode_modifier(record(0)); }
+    [[nodiscard]] auto get_ident() const noexcept -> Index { return record(1); }
+};
+
+class FunctionParameter : public View {
+  public:
+    static constexpr usize WIDTH = 2;
+
+  public:
+    using View::View;
+
+    [[nodiscard]] auto get_ident() const noexcept -> Index { return record(0); }
+    [[nodiscard]] auto get_type() const noexcept -> ExplicitType {
+        return ExplicitType{*ast_, record(1)};
+    }
+};
+
+class MatchArm : public View {
+  public:
+    static constexpr usize WIDTH = 3;
+
+    // Marks a capture clause that discards the matched value.
+    static constexpr Index DISCARDED = NONE - 1;
+
+  public:
+    using View::View;
+
+    [[nodiscard]] auto get_pattern() const noexcept -> Index { return record(0); }
+    [[nodiscard]] auto has_capture_clause() const noexcept -> bool { return record(1) != NONE; }
+    [[nodiscard]] auto is_discarded_capture() const noexcept -> bool {
+        return record(1) == DISCARDED;
+    }
+    [[nodiscard]] auto get_explicit_capture() const noexcept -> Index { return record(1); }
+    [[nodiscard]] auto get_dispatch() const noexcept -> Index { return record(2); }
+};
+
+class UnionField : public View {
+  public:
+    static constexpr usize WIDTH = 2;
+
+  public:
+    using View::View;
+
+    [[nodiscard]] auto get_ident() const noexcept -> Index { return record(0); }
+    [[nodiscard]] auto get_type() const noexcept -> ExplicitType {
+        return ExplicitType{*ast_, record(1)};
+    }
+};
+
+// Nodes, indexed into the node arrays. Child getters return node indices.
+
+class IdentifierExpression : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::IDENTIFIER_EXPRESSION;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_name() const -> std::string_view {
+        return ast_->tokens().slice(ast_->main_token(idx_));
+    }
+};
+
+// Literal values are stored inline, with strings pointing into the tree's string table.
+template <PrimitiveNode N> class PrimitiveExpression : public NodeView {
+  public:
+    static constexpr auto KIND = N::KIND;
+    using value_type           = typename N::value_type;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_value() const noexcept -> value_type {
+        const auto [lo, hi] = ast_->data(idx_);
+        if constexpr (std::same_as<value_type, std::string_view>) {
+            return ast_->string(lo, hi);
+        } else {
+            return decode_value<value_type>(static_cast<u64>(hi) << 32 | lo);
+        }
+    }
+};
+
+// Prefix operators keep their operand inline, and their operator is the start token.
+template <LeafNode N> class PrefixExpression : public NodeView {
+  public:
+    static constexpr auto KIND = N::KIND;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_op() const -> TokenType { return get_token().type; }
+    [[nodiscard]] auto get_rhs() const noexcept -> Index { return inline_operand(0); }
+};
+
+template <LeafNode N> class InfixExpression : public NodeView {
+  public:
+    static constexpr auto KIND = N::KIND;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_lhs() const noexcept -> Index { return operand(0); }
+    [[nodiscard]] auto get_op() const noexcept -> TokenType {
+        return static_cast<TokenType>(operand(1));
+    }
+    [[nodiscard]] auto get_rhs() const noexcept -> Index { return operand(2); }
+};
+
+class ArrayExpression : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::ARRAY_EXPRESSION;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto has_explicit_size() const noexcept -> bool { return operand(0) != NONE; }
+    [[nodiscard]] auto get_explicit_size() const noexcept -> Index { return operand(0); }
+    [[nodiscard]] auto get_item_type() const noexcept -> ExplicitType {
+        return ExplicitType{*ast_, operand(1)};
+    }
+    [[nodiscard]] auto get_items() const noexcept -> std::span<const Index> {
+        return ast_->operands(idx_).subspan(2);
+    }
+};
+
+class CallExpression : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::CALL_EXPRESSION;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_function() const noexcept -> Index { return operand(0); }
+    [[nodiscard]] auto get_arguments() const noexcept -> Records<CallArgument> {
+        const auto& [from, to] = ast_->data(idx_);
+        return {*ast_, from + 1, (to - from - 1) / CallArgument::WIDTH};
+    }
+};
+
+class DoWhileLoopExpression : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::DO_WHILE_LOOP_EXPRESSION;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_block() const noexcept -> Index { return inline_operand(0); }
+    [[nodiscard]] auto get_condition() const noexcept -> Index { return inline_operand(1); }
+};
+
+class EnumExpression : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::ENUM_EXPRESSION;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto has_underlying() const noexcept -> bool { return operand(0) != NONE; }
+    [[nodiscard]] auto get_underlying() const noexcept -> Index { return operand(0); }
+    [[nodiscard]] auto get_enumerations() const noexcept -> Records<Enumeration> {
+        const auto& [from, to] = ast_->data(idx_);
+        return {*ast_, from + 1, (to - from - 1) / Enumeration::WIDTH};
+    }
+};
+
+class ForLoopExpression : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::FOR_LOOP_EXPRESSION;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_block() const noexcept -> Index { return operand(0); }
+    [[nodiscard]] auto has_non_break() const noexcept -> bool { return operand(1) != NONE; }
+    [[nodiscard]] auto get_non_break() const noexcept -> Index { return operand(1); }
+    [[nodiscard]] auto get_iterables() const noexcept -> std::span<const Index> {
+        return ast_->operands(idx_).subspan(3, operand(2));
+    }
+    [[nodiscard]] auto get_captures() const noexcept -> Records<ForLoopCapture> {
+        const auto& [from, to] = ast_->data(idx_);
+        const auto first       = from + 3 + operand(2);
+        return {*ast_, first, (to - first) / ForLoopCapture::WIDTH};
+    }
+};
+
+class FunctionExpression : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::FUNCTION_EXPRESSION;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto has_self() const noexcept -> bool { return operand(1) != NONE; }
+    [[nodiscard]] auto get_self_modifier() const -> TypeModifier {
+        return decode_modifier(operand(0));
+    }
+    [[nodiscard]] auto get_self_ident() const noexcept -> Index { return operand(1); }
+    [[nodiscard]] auto get_return_type() const noexcept -> ExplicitType {
+        return ExplicitType{*ast_, operand(2)};
+    }
+    [[nodiscard]] auto has_body() const noexcept -> bool { return operand(3) != NONE; }
+    [[nodiscard]] auto get_body() const noexcept -> Index { return operand(3); }
+    [[nodiscard]] auto get_parameters() const noexcept -> Records<FunctionParameter> {
+        const auto& [from, to] = ast_->data(idx_);
+        return {*ast_, from + 4, (to - from - 4) / FunctionParameter::WIDTH};
+    }
+};
+
+class IfExpression : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::IF_EXPRESSION;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_condition() const noexcept -> Index { return operand(0); }
+    [[nodiscard]] auto get_consequence() const noexcept -> Index { return operand(1); }
+    [[nodiscard]] auto has_alternate() const noexcept -> bool { return operand(2) != NONE; }
+    [[nodiscard]] auto get_alternate() const noexcept -> Index { return operand(2); }
+};
+
+class IndexExpression : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::INDEX_EXPRESSION;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_array() const noexcept -> Index { return inline_operand(0); }
+    [[nodiscard]] auto get_index() const noexcept -> Index { return inline_operand(1); }
+};
+
+class InfiniteLoopExpression : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::INFINITE_LOOP_EXPRESSION;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_block() const noexcept -> Index { return inline_operand(0); }
+};
+
+class MatchExpression : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::MATCH_EXPRESSION;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_matcher() const noexcept -> Index { return operand(0); }
+    [[nodiscard]] auto has_catch_all() const noexcept -> bool { return operand(1) != NONE; }
+    [[nodiscard]] auto get_catch_all() const noexcept -> Index { return operand(1); }
+    [[nodiscard]] auto get_arms() const noexcept -> Records<MatchArm> {
+        const auto& [from, to] = ast_->data(idx_);
+        return {*ast_, from + 2, (to - from - 2) / MatchArm::WIDTH};
+    }
+};
+
+class ScopeResolutionExpression : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::SCOPE_RESOLUTION_EXPRESSION;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_outer() const noexcept -> Index { return inline_operand(0); }
+    [[nodiscard]] auto get_inner() const noexcept -> Index { return inline_operand(1); }
+};
+
+class StructExpression : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::STRUCT_EXPRESSION;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto is_packed() const -> bool { return get_token().type == TokenType::PACKED; }
+    [[nodiscard]] auto get_members() const noexcept -> std::span<const Index> {
+        return ast_->operands(idx_);
+    }
+};
+
+class TypeExpression : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::TYPE_EXPRESSION;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto has_explicit_type() const noexcept -> bool {
+        return inline_operand(0) != NONE;
+    }
+    [[nodiscard]] auto get_explicit_type() const noexcept -> ExplicitType {
+        return ExplicitType{*ast_, inline_operand(0)};
+    }
+};
+
+class UnionExpression : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::UNION_EXPRESSION;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_fields() const noexcept -> Records<UnionField> {
+        const auto& [from, to] = ast_->data(idx_);
+        return {*ast_, from, (to - from) / UnionField::WIDTH};
+    }
+};
+
+class WhileLoopExpression : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::WHILE_LOOP_EXPRESSION;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_condition() const noexcept -> Index { return operand(0); }
+    [[nodiscard]] auto has_continuation() const noexcept -> bool { return operand(1) != NONE; }
+    [[nodiscard]] auto get_continuation() const noexcept -> Index { return operand(1); }
+    [[nodiscard]] auto get_block() const noexcept -> Index { return operand(2); }
+    [[nodiscard]] auto has_non_break() const noexcept -> bool { return operand(3) != NONE; }
+    [[nodiscard]] auto get_non_break() const noexcept -> Index { return operand(3); }
+};
+
+class BlockStatement : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::BLOCK_STATEMENT;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_statements() const noexcept -> std::span<const Index> {
+        return ast_->operands(idx_);
+    }
+    [[nodiscard]] auto empty() const noexcept -> bool { return get_statements().empty(); }
+};
+
+class DeclStatement : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::DECL_STATEMENT;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_ident() const noexcept -> Index { return operand(0); }
+    [[nodiscard]] auto get_type() const noexcept -> Index { return operand(1); }
+    [[nodiscard]] auto has_value() const noexcept -> bool { return operand(2) != NONE; }
+    [[nodiscard]] auto get_value() const noexcept -> Index { return operand(2); }
+    [[nodiscard]] auto get_modifiers() const noexcept -> DeclModifiers {
+        return static_cast<DeclModifiers>(operand(3));
+    }
+};
+
+// Statements wrapping a single child keep it inline.
+template <LeafNode N> class WrapperStatement : public NodeView {
+  public:
+    static constexpr auto KIND = N::KIND;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_inner() const noexcept -> Index { return inline_operand(0); }
+};
+
+class ImportStatement : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::IMPORT_STATEMENT;
+
+  public:
+    using NodeView::NodeView;
+
+    // The imported module identifier or user string literal, told apart by their kinds.
+    [[nodiscard]] auto get_imported() const noexcept -> Index { return inline_operand(0); }
+    [[nodiscard]] auto is_module_import() const noexcept -> bool {
+        return ast_->kind(get_imported()) == NodeKind::IDENTIFIER_EXPRESSION;
+    }
+    [[nodiscard]] auto has_alias() const noexcept -> bool { return inline_operand(1) != NONE; }
+    [[nodiscard]] auto get_alias() const noexcept -> Index { return inline_operand(1); }
+};
+
+class JumpStatement : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::JUMP_STATEMENT;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto has_expression() const noexcept -> bool {
+        return inline_operand(0) != NONE;
+    }
+    [[nodiscard]] auto get_expression() const noexcept -> Index { return inline_operand(0); }
+};
+
+class UsingStatement : public NodeView {
+  public:
+    static constexpr auto KIND = NodeKind::USING_STATEMENT;
+
+  public:
+    using NodeView::NodeView;
+
+    [[nodiscard]] auto get_alias() const noexcept -> Index { return inline_operand(0); }
+    [[nodiscard]] auto get_type() const noexcept -> ExplicitType {
+        return ExplicitType{*ast_, inline_operand(1)};
+    }
+};
+
+} // namespace flat
+
+} // namespace conch::ast
@@ -20,6 +20,7 @@ enum class NodeKind : u8 {
     ARRAY_EXPRESSION,
     ASSIGNMENT_EXPRESSION,
     BINARY_EXPRESSION,
+    BINARY_CHAIN_EXPRESSION,
     CALL_EXPRESSION,
     DO_WHILE_LOOP_EXPRESSION,
     DOT_EXPRESSION,
@@ -82,6 +83,9 @@ concept LeafNode = NodeSubtype<T> && requires {
     { T::KIND } -> std::convertible_to<NodeKind>;
 };
 
+// The base of every tree node. Parsed nodes are carved from the parser's arena, which never runs
+// their destructors, so a node must not own heap memory. Whatever it points to has to live in the
+// same arena or in state its tree retains.
 class Node {
   public:
     Node()          = delete;
@@ -124,10 +128,11 @@ class Node {
     }
 
   protected:
-    const Token    start_token_;
+    Token          start_token_;
     const NodeKind kind_;
 
     friend class ExplicitType;
+    friend class TokenShifter;
 };
 
 template <typename Derived, typename Base> class NodeBase : public Base {
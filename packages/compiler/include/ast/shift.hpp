@@ -0,0 +1,76 @@
+#pragma once
+
+#include <string_view>
+
+#include "lexer/token.hpp"
+
+#include "types.hpp"
+
+namespace conch {
+
+class DeferredSource;
+
+} // namespace conch
+
+namespace conch::ast {
+
+class Node;
+class BlockStatement;
+class FunctionExpression;
+
+// Where the text after an edit moved to. Every token behind the edit moves by the same number of
+// bytes and lines, but only those on the line the edit ended on change columns. Tokens in front of
+// the edit are only moved onto the edited source.
+struct TokenShift {
+    std::string_view from;
+    std::string_view to;
+
+    // Tokens from this offset in the previous source on are behind the edit and move by the rest.
+    usize behind{0};
+    isize offset{0};
+    isize lines{0};
+    usize line{0};
+    isize columns{0};
+
+    // Deferred bodies resume from the edited source's tokens, where the old ones from the index
+    // behind the edit on moved by this many indices. Without a source they are parsed from the
+    // previous source before shifting.
+    const DeferredSource* deferred{nullptr};
+    usize                 behind_index{0};
+    isize                 tokens{0};
+
+    // Finds the shift from the first token behind the edit and the same token in the edited
+    // source.
+    [[nodiscard]] static auto between(std::string_view from,
+                                      const Token&     before,
+                                      std::string_view to,
+                                      const Token&     after) noexcept -> TokenShift;
+
+    [[nodiscard]] auto apply(const Token& token) const noexcept -> Token;
+    [[nodiscard]] auto apply(usize token_index) const noexcept -> usize;
+};
+
+// The block of a statement that an edit fell inside of. A deferred body is only found as a whole,
+// since the blocks inside of it have not been parsed.
+struct EnclosingBlock {
+    const BlockStatement*     block{nullptr};
+    const FunctionExpression* deferred{nullptr};
+};
+
+// Moves the tokens of a node and everything below it into the edited source. Deferred bodies that
+// were never read or failed to parse are pointed at the edited source instead, so they are read
+// from it like any other skipped body. The node is changed in place.
+auto shift_tokens(const Node& node, const TokenShift& shift) -> void;
+
+// Moves a node into the edited source like shift_tokens, replacing the statements of one of its
+// blocks with those of a block parsed from the edited source. The old statements are dropped
+// without being shifted, and the new ones are already in place.
+auto shift_tokens(const Node&           node,
+                  const TokenShift&     shift,
+                  const BlockStatement& block,
+                  BlockStatement&&      replacement) -> void;
+
+// Finds the block of a node that opens at the brace, by where the brace is in the node's source.
+[[nodiscard]] auto find_block(const Node& node, const Token& brace) -> EnclosingBlock;
+
+} // namespace conch::ast
@@ -2,12 +2,13 @@
 
 #include <algorithm>
 #include <utility>
-#include <vector>
 
 #include "ast/node.hpp"
 
 #include "parser/parser.hpp"
 
+#include "arena.hpp"
+
 namespace conch::ast {
 
 class BlockStatement : public StmtBase<BlockStatement> {
@@ -15,13 +16,14 @@ class BlockStatement : public StmtBase<BlockStatement> {
     static constexpr auto KIND = NodeKind::BLOCK_STATEMENT;
 
   public:
-    using iterator       = typename std::vector<Box<Statement>>::iterator;
-    using const_iterator = typename std::vector<Box<Statement>>::const_iterator;
+    using iterator       = typename ArenaVector<Box<Statement>>::iterator;
+    using const_iterator = typename ArenaVector<Box<Statement>>::const_iterator;
 
   public:
     explicit BlockStatement(const Token&                start_token,
-                            std::vector<Box<Statement>> statements) noexcept
-        : StmtBase{start_token}, statements_{std::move(statements)} {}
+                            ArenaVector<Box<Statement>> statements,
+                            usize                       depth = 0) noexcept
+        : StmtBase{start_token}, statements_{std::move(statements)}, depth_{depth} {}
 
     MAKE_AST_COPY_MOVE(BlockStatement)
 
@@ -37,6 +39,9 @@ class BlockStatement : public StmtBase<BlockStatement> {
     [[nodiscard]] auto size() const noexcept -> std::size_t { return statements_.size(); }
     [[nodiscard]] auto empty() const noexcept -> bool { return statements_.empty(); }
 
+    // The nesting depth the statements were parsed at, so that they can be parsed again alone.
+    MAKE_AST_GETTER(depth, usize, )
+
   protected:
     auto is_equal(const Node& other) const noexcept -> bool override {
         const auto& casted = as<BlockStatement>(other);
@@ -45,7 +50,10 @@ class BlockStatement : public StmtBase<BlockStatement> {
     }
 
   private:
-    std::vector<Box<Statement>> statements_;
+    ArenaVector<Box<Statement>> statements_;
+    usize                       depth_;
+
+    friend class TokenShifter;
 };
 
 } // namespace conch::ast
@@ -1,8 +1,8 @@
 #pragma once
 
-#include <algorithm>
 #include <array>
 #include <bit>
+#include <utility>
 
 #include <magic_enum/magic_enum_flags.hpp>
 
@@ -111,9 +111,19 @@ class DeclStatement : public StmtBase<DeclStatement> {
         return valid_mut && valid_comptime && valid_abi && valid_access;
     }
 
+    // Modifiers indexed by token type, where an empty flag set marks a non-modifier token.
+    static constexpr auto MODIFIERS_BY_TYPE = []() {
+        std::array<DeclModifiers, TOKEN_TYPE_COUNT> modifiers{};
+        for (const auto& [tt, modifier] : LEGAL_MODIFIERS) {
+            modifiers[std::to_underlying(tt)] = modifier;
+        }
+        return modifiers;
+    }();
+
     static constexpr auto token_to_modifier(const Token& tok) -> Optional<DeclModifiers> {
-        const auto it = std::ranges::find(LEGAL_MODIFIERS, tok.type, &ModifierMapping::first);
-        return it == LEGAL_MODIFIERS.end() ? nullopt : Optional<DeclModifiers>{it->second};
+        const auto modifier = MODIFIERS_BY_TYPE[std::to_underlying(tok.type)];
+        if (std::to_underlying(modifier) == 0) { return nullopt; }
+        return Optional<DeclModifiers>{modifier};
     }
 
   private:
@@ -15,6 +15,7 @@ namespace conch::ast {
     X(InfiniteLoopExpression)        \
     X(AssignmentExpression)          \
     X(BinaryExpression)              \
+    X(BinaryChainExpression)         \
     X(DotExpression)                 \
     X(RangeExpression)               \
     X(ImplicitDereferenceExpression) \
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <utility>
+
+#include "lexer/operators.hpp"
+#include "lexer/token.hpp"
+
+#include "types.hpp"
+
+namespace conch {
+
+// Everything the lexer needs to know about a byte, independent of the process locale.
+enum class CharClass : u8 {
+    NONE           = 0,
+    IDENT_START    = 1 << 0,
+    IDENT_CONTINUE = 1 << 1,
+    DIGIT          = 1 << 2,
+    HEX_DIGIT      = 1 << 3,
+    WHITESPACE     = 1 << 4,
+    OPERATOR_START = 1 << 5,
+    MISC           = 1 << 6,
+};
+
+constexpr auto operator|(CharClass lhs, CharClass rhs) noexcept -> CharClass {
+    return static_cast<CharClass>(std::to_underlying(lhs) | std::to_underlying(rhs));
+}
+
+constexpr auto operator&(CharClass lhs, CharClass rhs) noexcept -> CharClass {
+    return static_cast<CharClass>(std::to_underlying(lhs) & std::to_underlying(rhs));
+}
+
+constexpr auto operator|=(CharClass& lhs, CharClass rhs) noexcept -> CharClass& {
+    lhs = lhs | rhs;
+    return lhs;
+}
+
+// The token a byte starts when it does not begin an operator.
+enum class LexAction : u8 {
+    ILLEGAL,
+    END,
+    MISC,
+    BUILTIN,
+    IDENT,
+    NUMBER,
+    STRING,
+    BYTE,
+    UNICODE,
+};
+
+struct CharInfo {
+    CharClass classes{CharClass::NONE};
+    LexAction action{LexAction::ILLEGAL};
+    TokenType misc{TokenType::ILLEGAL};
+
+    [[nodiscard]] constexpr auto is(CharClass cls) const noexcept -> bool {
+        return (classes & cls) != CharClass::NONE;
+    }
+};
+
+constexpr auto CHAR_INFO = []() {
+    std::array<CharInfo, 256> table{};
+    const auto at = [&table](byte c) noexcept -> CharInfo& { return table[static_cast<u8>(c)]; };
+
+    for (auto c = 'a'; c <= 'z'; ++c) {
+        for (const auto letter : {c, static_cast<byte>(c - 'a' + 'A')}) {
+            at(letter).classes = CharClass::IDENT_START | CharClass::IDENT_CONTINUE;
+            at(letter).action  = LexAction::IDENT;
+            if (c <= 'f') { at(letter).classes |= CharClass::HEX_DIGIT; }
+        }
+    }
+
+    for (auto c = '0'; c <= '9'; ++c) {
+        at(c).classes = CharClass::DIGIT | CharClass::HEX_DIGIT | CharClass::IDENT_CONTINUE;
+        at(c).action  = LexAction::NUMBER;
+    }
+
+    for (const auto c : {' ', '\t', '\n', '\v', '\f', '\r'}) {
+        at(c).classes = CharClass::WHITESPACE;
+    }
+
+    for (usize c = 0; c < table.size(); ++c) {
+        const auto misc = token_type::misc_from_char(static_cast<byte>(c));
+        if (misc) {
+            table[c].classes |= CharClass::MISC;
+            table[c].action = LexAction::MISC;
+            table[c].misc   = *misc;
+        }
+    }
+    at('_').classes |= CharClass::IDENT_CONTINUE;
+
+    for (const auto& [op, _] : ALL_OPERATORS) {
+        at(op.front()).classes |= CharClass::OPERATOR_START;
+    }
+
+    // Non-ASCII bytes lead or continue a UTF-8 sequence that has to be decoded to classify
+    for (usize c = 0x80; c < table.size(); ++c) { table[c].action = LexAction::UNICODE; }
+
+    at('\0').action = LexAction::END;
+    at('@').action  = LexAction::BUILTIN;
+    at('"').action  = LexAction::STRING;
+    at('\'').action = LexAction::BYTE;
+    return table;
+}();
+
+[[nodiscard]] constexpr auto char_info(byte c) noexcept -> const CharInfo& {
+    return CHAR_INFO[static_cast<u8>(c)];
+}
+
+[[nodiscard]] constexpr auto char_is(byte c, CharClass cls) noexcept -> bool {
+    return char_info(c).is(cls);
+}
+
+} // namespace conch
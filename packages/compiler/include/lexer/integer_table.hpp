@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+#include "optional.hpp"
+#include "types.hpp"
+
+namespace conch {
+
+// An integer literal's value as decoded by the lexer while it scanned the digits.
+struct IntegerLiteral {
+    u32  offset;
+    bool overflow;
+    u64  value;
+};
+
+// A side table of decoded integer literals, sorted by the source offset of their tokens.
+class IntegerTable {
+  public:
+    auto clear() noexcept -> void { literals_.clear(); }
+
+    // Records a literal, forgetting any at or past its offset so that relexing after a rewind keeps
+    // the table sorted and free of stale entries.
+    auto record(usize offset, u64 value, bool overflow) -> void;
+
+    // Records the literals of another table from the given offset onwards.
+    auto append(const IntegerTable& other, usize from) -> void;
+
+    [[nodiscard]] auto find(usize offset) const noexcept -> Optional<IntegerLiteral>;
+    [[nodiscard]] auto size() const noexcept -> usize { return literals_.size(); }
+
+  private:
+    std::vector<IntegerLiteral> literals_;
+};
+
+} // namespace conch
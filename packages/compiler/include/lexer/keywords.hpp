@@ -6,6 +6,7 @@
 #include <utility>
 
 #include "optional.hpp"
+#include "perfect_hash.hpp"
 
 #include "lexer/token.hpp"
 
@@ -116,10 +117,10 @@ constexpr auto ALL_KEYWORDS = []() {
     return all_keywords;
 }();
 
+constexpr PerfectHashMap KEYWORD_TABLE{ALL_KEYWORDS};
+
 constexpr auto get_keyword(std::string_view sv) noexcept -> Optional<Keyword> {
-    const auto it = std::ranges::lower_bound(ALL_KEYWORDS, sv, {}, &Keyword::first);
-    if (it == ALL_KEYWORDS.end() || it->first != sv) { return nullopt; }
-    return Optional<Keyword>{*it};
+    return KEYWORD_TABLE.find(sv);
 }
 
 constexpr auto ALL_PRIMITIVES = std::array{
@@ -176,21 +177,36 @@ constexpr auto ALL_BUILTINS = []() {
     return all_builtins;
 }();
 
+constexpr PerfectHashMap BUILTIN_TABLE{ALL_BUILTINS};
+
 constexpr auto get_builtin(std::string_view sv) noexcept -> Optional<Keyword> {
-    const auto it = std::ranges::lower_bound(ALL_BUILTINS, sv, {}, &Keyword::first);
-    if (it == ALL_BUILTINS.end() || it->first != sv) { return nullopt; }
-    return Optional<Keyword>{*it};
+    return BUILTIN_TABLE.find(sv);
+}
+
+// Keyword classifications, indexed directly by token type so checks take a single load.
+enum class KeywordClass : u8 {
+    NONE      = 0,
+    PRIMITIVE = 1 << 0,
+    BUILTIN   = 1 << 1,
+};
+
+constexpr auto KEYWORD_CLASSES = []() {
+    std::array<KeywordClass, TOKEN_TYPE_COUNT> classes{};
+    for (const auto tt : ALL_PRIMITIVES) {
+        classes[std::to_underlying(tt)] = KeywordClass::PRIMITIVE;
+    }
+    for (const auto& [_, tt] : ALL_BUILTINS) {
+        classes[std::to_underlying(tt)] = KeywordClass::BUILTIN;
+    }
+    return classes;
+}();
+
+constexpr auto is_primitive(TokenType tt) noexcept -> bool {
+    return KEYWORD_CLASSES[std::to_underlying(tt)] == KeywordClass::PRIMITIVE;
 }
 
 constexpr auto is_builtin(TokenType tt) noexcept -> bool {
-    constexpr auto ALL_BUILTINS_BY_TT = [] {
-        auto arr = ALL_BUILTINS;
-        std::ranges::sort(arr, {}, &Keyword::second);
-        return arr;
-    }();
-
-    const auto it = std::ranges::lower_bound(ALL_BUILTINS_BY_TT, tt, {}, &Keyword::second);
-    return it != ALL_BUILTINS_BY_TT.end() && it->second == tt;
+    return KEYWORD_CLASSES[std::to_underlying(tt)] == KeywordClass::BUILTIN;
 }
 
 } // namespace conch
@@ -2,17 +2,85 @@
 
 #include <cstdint>
 #include <iterator>
+#include <string>
 #include <string_view>
+#include <type_traits>
+#include <variant>
 #include <vector>
 
+#include "lexer/integer_table.hpp"
 #include "lexer/token.hpp"
+#include "lexer/token_buffer.hpp"
+#include "lexer/trivia.hpp"
 
 #include "optional.hpp"
 #include "types.hpp"
 
 namespace conch {
 
-class Lexer {
+struct ParallelLexOptions {
+    // The number of workers to lex with, where zero uses the hardware concurrency.
+    usize threads{0};
+
+    // Inputs are never split into chunks smaller than this, so small files are lexed serially.
+    usize min_chunk_size{usize{1} << 18};
+};
+
+// Replaces the bytes in [offset, offset + length) of a source with new text.
+struct TextEdit {
+    usize            offset{0};
+    usize            length{0};
+    std::string_view replacement{};
+
+    [[nodiscard]] auto apply(std::string_view source) const -> std::string {
+        std::string edited{source.substr(0, offset)};
+        edited.append(replacement);
+        edited.append(source.substr(offset + length));
+        return edited;
+    }
+
+    // The signed change in source size caused by the edit.
+    [[nodiscard]] auto delta() const noexcept -> isize {
+        return static_cast<isize>(replacement.size()) - static_cast<isize>(length);
+    }
+};
+
+// Compile-time switches for the features a lexer carries. Disabled features are compiled out of the
+// instantiation rather than checked as it scans.
+struct LexerPolicy {
+    // Tokens carry line and column numbers. Bulk lexing produces offset-only tokens, so it always
+    // runs on the sibling instantiation that leaves them out.
+    bool track_positions{true};
+
+    // Comments are produced as tokens rather than skipped along with whitespace.
+    bool emit_comments{true};
+
+    // Integer literals are decoded into the integer table as they are scanned.
+    bool decode_integers{true};
+
+    // The whitespace and comments skipped before each token are recorded in a trivia table.
+    bool retain_trivia{false};
+
+    [[nodiscard]] constexpr auto without_positions() const noexcept -> LexerPolicy {
+        auto policy            = *this;
+        policy.track_positions = false;
+        return policy;
+    }
+};
+
+// The parser discards comments, so they never reach it as tokens. Comments are accepted
+// anywhere whitespace is, including inside blocks and expressions.
+constexpr LexerPolicy PARSER_LEXER_POLICY{.emit_comments = false};
+
+// Syntax highlighting only needs token kinds and offsets.
+constexpr LexerPolicy HIGHLIGHT_LEXER_POLICY{.track_positions = false, .decode_integers = false};
+
+// Formatters see the parser's token stream, with everything it skips kept on the side.
+constexpr LexerPolicy TRIVIA_LEXER_POLICY{.emit_comments = false, .retain_trivia = true};
+
+template <LexerPolicy Policy> class BasicLexer {
+    template <LexerPolicy> friend class BasicLexer;
+
   public:
     class Iterator {
       public:
@@ -23,7 +91,7 @@ class Lexer {
         using reference         = const Token&;
 
       public:
-        explicit Iterator(Lexer& lexer, const Token& current_token)
+        explicit Iterator(BasicLexer& lexer, const Token& current_token)
             : lexer_{lexer}, current_token_{current_token} {}
 
         auto operator++() -> Iterator& {
@@ -39,31 +107,51 @@ class Lexer {
         }
 
       private:
-        Lexer& lexer_;
-        Token  current_token_;
-    };
-
-    class Snapshot {
-      public:
-        explicit Snapshot(const Lexer& l) noexcept;
-
-      private:
-        usize pos_;
-        usize peek_pos_;
-        byte  current_byte_;
-        usize line_no_;
-        usize col_no_;
-
-        friend class Lexer;
+        BasicLexer& lexer_;
+        Token       current_token_;
     };
 
   public:
-    Lexer() noexcept = default;
-    explicit Lexer(std::string_view input) noexcept : input_{input} { read_character(); }
+    BasicLexer() noexcept = default;
+    explicit BasicLexer(std::string_view input) noexcept : input_{input} {
+        if constexpr (Policy.retain_trivia) { trivia_ = TriviaTable{input}; }
+        read_character();
+    }
 
     auto reset(std::string_view input = {}) noexcept -> void;
     auto advance() noexcept -> Token;
-    auto consume() -> std::vector<Token>;
+
+    // Lexes the whole input into offset-only tokens without tracking lines and columns, catching
+    // up on them once at the end. The buffer recovers locations when tokens are read.
+    auto consume() -> TokenBuffer;
+
+    // Lexes the whole input like consume, splitting it into chunks at newlines that are lexed on
+    // worker threads and stitched back together.
+    //
+    // Chunks may start inside a string or comment, so each one is lexed speculatively and only
+    // kept once the stream before it lands on one of its token starts. Chunks that never line up
+    // are relexed serially from where the stream left off. Lexers retaining trivia lex serially.
+    auto consume_parallel(const ParallelLexOptions& options = {}) -> TokenBuffer;
+
+    // Produces the tokens of the current input, which must be the result of applying the edit to
+    // the source that `previous` was lexed from.
+    //
+    // Tokens that ended well before the edit are reused as is. Lexing resumes after the last of
+    // them and stops as soon as a new token starts where a shifted old token did, since the lexer
+    // carries no state between tokens. The rest of the old stream is reused with shifted offsets.
+    // Lexers retaining trivia lex the whole input again.
+    auto relex(const TokenBuffer& previous, const TextEdit& edit) -> TokenBuffer;
+
+    // The values of integer literals decoded since the last reset, keyed by token offset. Relexing
+    // only decodes the literals in the window it actually lexes.
+    [[nodiscard]] auto integers() const noexcept -> const IntegerTable& { return integers_; }
+
+    // The trivia before each token lexed since the last reset, indexed in lexing order.
+    [[nodiscard]] auto trivia() const noexcept -> const TriviaTable&
+        requires(Policy.retain_trivia)
+    {
+        return trivia_;
+    }
 
     auto begin() noexcept -> Iterator { return Iterator{*this, advance()}; }
     auto end() const noexcept // cppcheck-suppress functionStatic
@@ -73,12 +161,17 @@ class Lexer {
 
   private:
     auto        skip_whitespace() noexcept -> void;
+    auto        compact(const Token& token) const noexcept -> CompactToken;
+    auto        lex_chunk(usize from, usize until, TokenBuffer& tokens) -> usize;
+    template <typename F> auto lex_untracked(F&& lex) -> TokenBuffer;
     static auto lu_builtin(std::string_view ident) noexcept -> TokenType;
     static auto lu_ident(std::string_view ident) noexcept -> TokenType;
 
     auto read_character(uint8_t n = 1) noexcept -> void;
+    auto jump_to(usize target) noexcept -> void;
     auto read_operator() const noexcept -> Optional<Token>;
-    auto read_ident(bool builtin) noexcept -> std::string_view;
+    auto unicode_ident_length(bool (*property)(char32_t) noexcept) const noexcept -> u8;
+    auto read_ident() noexcept -> std::string_view;
     auto read_number() noexcept -> Token;
     auto read_escape() noexcept -> byte;
     auto read_string() noexcept -> Token;
@@ -86,15 +179,6 @@ class Lexer {
     auto read_byte_literal() noexcept -> Token;
     auto read_comment() noexcept -> Token;
 
-    // Sets the lexer to the snapshot, very cheap operation.
-    auto restore(const Snapshot& state) noexcept -> void {
-        pos_          = state.pos_;
-        peek_pos_     = state.peek_pos_;
-        current_byte_ = state.current_byte_;
-        line_no_      = state.line_no_;
-        col_no_       = state.col_no_;
-    }
-
   private:
     std::string_view input_{};
     usize            pos_{0};
@@ -104,7 +188,22 @@ class Lexer {
     usize line_no_{1};
     usize col_no_{0};
 
-    friend class Parser;
+    IntegerTable integers_;
+
+    // Lexers that do not retain trivia pay nothing for it, not even space
+    [[no_unique_address]] std::conditional_t<Policy.retain_trivia, TriviaTable, std::monostate>
+        trivia_{};
 };
 
+extern template class BasicLexer<LexerPolicy{}>;
+extern template class BasicLexer<PARSER_LEXER_POLICY>;
+extern template class BasicLexer<HIGHLIGHT_LEXER_POLICY>;
+extern template class BasicLexer<TRIVIA_LEXER_POLICY>;
+
+// Every feature enabled, which is the behavior the lexer has always had.
+using Lexer          = BasicLexer<LexerPolicy{}>;
+using ParserLexer    = BasicLexer<PARSER_LEXER_POLICY>;
+using HighlightLexer = BasicLexer<HIGHLIGHT_LEXER_POLICY>;
+using TriviaLexer    = BasicLexer<TRIVIA_LEXER_POLICY>;
+
 } // namespace conch
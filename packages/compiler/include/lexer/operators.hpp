@@ -2,10 +2,12 @@
 
 #include <algorithm>
 #include <array>
+#include <limits>
 #include <string_view>
 #include <utility>
 
 #include "optional.hpp"
+#include "types.hpp"
 
 #include "lexer/token.hpp"
 
@@ -125,4 +127,98 @@ constexpr auto get_operator(std::string_view sv) noexcept -> Optional<Operator>
     return Optional<Operator>{*it};
 }
 
+namespace operators::detail {
+
+// Folds every byte into an equivalence class, where 0 marks bytes that appear in no operator.
+constexpr auto BYTE_CLASSES = []() {
+    std::array<u8, 256> classes{};
+    u8                  next_class = 1;
+    for (const auto& [op, _] : ALL_OPERATORS) {
+        for (const auto c : op) {
+            auto& cls = classes[static_cast<u8>(c)];
+            if (cls == 0) { cls = next_class++; }
+        }
+    }
+    return classes;
+}();
+
+constexpr usize CLASS_COUNT = *std::ranges::max_element(BYTE_CLASSES) + 1;
+
+// Every distinct operator prefix becomes a trie state, with the empty prefix as the root.
+constexpr usize STATE_COUNT = []() {
+    usize states = 1;
+    for (usize i = 0; i < ALL_OPERATORS.size(); ++i) {
+        const auto op = ALL_OPERATORS[i].first;
+        for (usize len = 1; len <= op.size(); ++len) {
+            const auto prefix = op.substr(0, len);
+            const auto seen   = std::ranges::any_of(ALL_OPERATORS.begin(),
+                                                  ALL_OPERATORS.begin() + i,
+                                                  [&](const auto& earlier) noexcept {
+                                                      return earlier.first.starts_with(prefix);
+                                                  });
+            if (!seen) { states += 1; }
+        }
+    }
+    return states;
+}();
+
+static_assert(STATE_COUNT <= std::numeric_limits<u8>::max());
+
+// A DFA over the byte classes where state 0 doubles as the root and the dead transition.
+struct OperatorDfa {
+    std::array<std::array<u8, CLASS_COUNT>, STATE_COUNT> next{};
+    std::array<TokenType, STATE_COUNT>                   accept{};
+};
+
+constexpr auto OPERATOR_DFA = []() {
+    OperatorDfa dfa{};
+    dfa.accept.fill(TokenType::ILLEGAL);
+
+    u8 states = 1;
+    for (const auto& [op, type] : ALL_OPERATORS) {
+        u8 state = 0;
+        for (const auto c : op) {
+            auto& target = dfa.next[state][BYTE_CLASSES[static_cast<u8>(c)]];
+            if (target == 0) { target = states++; }
+            state = target;
+        }
+        dfa.accept[state] = type;
+    }
+    return dfa;
+}();
+
+} // namespace operators::detail
+
+// Returns the longest operator that prefixes the input in a single forward pass.
+//
+// Bytes that start no operator are rejected immediately, so identifiers and literals pay for a
+// single table lookup.
+constexpr auto match_operator(std::string_view input) noexcept -> Optional<Operator> {
+    using namespace operators::detail;
+
+    u8    state       = 0;
+    usize matched_len = 0;
+    auto  matched     = TokenType::ILLEGAL;
+    for (usize i = 0; i < input.size(); ++i) {
+        const auto cls = BYTE_CLASSES[static_cast<u8>(input[i])];
+        if (cls == 0) { break; }
+
+        state = OPERATOR_DFA.next[state][cls];
+        if (state == 0) { break; }
+
+        if (OPERATOR_DFA.accept[state] != TokenType::ILLEGAL) {
+            matched     = OPERATOR_DFA.accept[state];
+            matched_len = i + 1;
+        }
+    }
+
+    if (matched_len == 0) { return nullopt; }
+    return Operator{input.substr(0, matched_len), matched};
+}
+
+static_assert(std::ranges::all_of(ALL_OPERATORS, [](const auto& op) {
+    const auto matched = match_operator(op.first);
+    return matched && matched->first == op.first && matched->second == op.second;
+}));
+
 } // namespace conch
@@ -9,6 +9,7 @@
 
 #include "diagnostic.hpp"
 #include "expected.hpp"
+#include "line_index.hpp"
 #include "optional.hpp"
 #include "source_loc.hpp"
 #include "types.hpp"
@@ -200,6 +201,9 @@ enum class TokenType : u8 {
     ILLEGAL,
 };
 
+// The number of token types, for tables indexed directly by type.
+constexpr usize TOKEN_TYPE_COUNT = std::to_underlying(TokenType::ILLEGAL) + 1;
+
 enum class Base : u8 {
     BINARY      = 2,
     OCTAL       = 8,
@@ -252,7 +256,22 @@ consteval auto to_int_category(TokenType tt) noexcept -> IntegerCategory {
 }
 
 auto to_base(TokenType tt) noexcept -> Optional<Base>;
-auto misc_from_char(byte b) noexcept -> Optional<TokenType>;
+
+constexpr auto misc_from_char(byte c) noexcept -> Optional<TokenType> {
+    switch (c) {
+    case ',': return TokenType::COMMA;
+    case ':': return TokenType::COLON;
+    case ';': return TokenType::SEMICOLON;
+    case '(': return TokenType::LPAREN;
+    case ')': return TokenType::RPAREN;
+    case '{': return TokenType::LBRACE;
+    case '}': return TokenType::RBRACE;
+    case '[': return TokenType::LBRACKET;
+    case ']': return TokenType::RBRACKET;
+    case '_': return TokenType::UNDERSCORE;
+    default:  return nullopt;
+    }
+}
 
 constexpr auto is_signed_int(TokenType tt) noexcept -> bool {
     return TokenType::INT_2 <= tt && tt <= TokenType::INT_16;
@@ -320,6 +339,31 @@ template <> struct SourceInfo<Token> {
     static auto get(const Token& t) -> SourceLocation { return {t.line, t.column}; }
 };
 
+// A token reduced to its byte range in the source, which is a third of the size of a Token.
+//
+// Locations are recovered through a LineIndex only when something needs to report them.
+struct CompactToken {
+    u32       offset{};
+    u32       length{};
+    TokenType type{};
+
+    [[nodiscard]] auto slice(std::string_view source) const noexcept -> std::string_view {
+        return source.substr(offset, length);
+    }
+
+    [[nodiscard]] auto locate(const LineIndex& lines) const noexcept -> SourceLocation {
+        return lines.locate(offset);
+    }
+
+    [[nodiscard]] auto expand(std::string_view source, const LineIndex& lines) const noexcept
+        -> Token {
+        const auto [line, column] = locate(lines);
+        return {type, slice(source), line, column};
+    }
+
+    auto operator==(const CompactToken& other) const noexcept -> bool = default;
+};
+
 } // namespace conch
 
 template <> struct fmt::formatter<conch::Token> {
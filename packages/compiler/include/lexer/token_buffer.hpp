@@ -0,0 +1,158 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "lexer/token.hpp"
+
+#include "line_index.hpp"
+#include "source_limits.hpp"
+#include "types.hpp"
+
+namespace conch {
+
+// A token stream stored as parallel arrays of types, offsets and lengths.
+//
+// Scans that only care about token kinds touch a single byte per token. Full tokens are
+// materialized on access, with their locations resolved through a lazily built line index.
+class TokenBuffer {
+  public:
+    // Tokens are materialized by value, which only makes this a legacy input iterator even though
+    // it models std::random_access_iterator.
+    class Iterator {
+      public:
+        using iterator_concept  = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = Token;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = Token;
+
+      public:
+        Iterator() noexcept = default;
+        Iterator(const TokenBuffer& buffer, usize idx) noexcept : buffer_{&buffer}, idx_{idx} {}
+
+        auto operator*() const -> reference { return (*buffer_)[idx_]; }
+        auto operator[](difference_type n) const -> reference {
+            return (*buffer_)[static_cast<usize>(static_cast<difference_type>(idx_) + n)];
+        }
+
+        auto operator++() noexcept -> Iterator& {
+            idx_ += 1;
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> Iterator {
+            auto copy = *this;
+            idx_ += 1;
+            return copy;
+        }
+
+        auto operator--() noexcept -> Iterator& {
+            idx_ -= 1;
+            return *this;
+        }
+
+        auto operator--(int) noexcept -> Iterator {
+            auto copy = *this;
+            idx_ -= 1;
+            return copy;
+        }
+
+        auto operator+=(difference_type n) noexcept -> Iterator& {
+            idx_ = static_cast<usize>(static_cast<difference_type>(idx_) + n);
+            return *this;
+        }
+
+        auto operator-=(difference_type n) noexcept -> Iterator& { return *this += -n; }
+
+        friend auto operator+(Iterator it, difference_type n) noexcept -> Iterator {
+            return it += n;
+        }
+
+        friend auto operator+(difference_type n, Iterator it) noexcept -> Iterator {
+            return it += n;
+        }
+
+        friend auto operator-(Iterator it, difference_type n) noexcept -> Iterator {
+            return it -= n;
+        }
+
+        friend auto operator-(const Iterator& a, const Iterator& b) noexcept -> difference_type {
+            return static_cast<difference_type>(a.idx_) - static_cast<difference_type>(b.idx_);
+        }
+
+        auto operator==(const Iterator& other) const noexcept -> bool { return idx_ == other.idx_; }
+        auto operator<=>(const Iterator& other) const noexcept { return idx_ <=> other.idx_; }
+
+      private:
+        const TokenBuffer* buffer_{nullptr};
+        usize              idx_{0};
+    };
+
+  public:
+    TokenBuffer() noexcept = default;
+
+    // Offsets and lengths are stored as u32, so sources must be no larger than tokens can address.
+    explicit TokenBuffer(std::string_view source) noexcept : source_{source} {
+        static_assert(MAX_SOURCE_SIZE <= std::numeric_limits<u32>::max());
+        assert(source.size() <= MAX_SOURCE_SIZE);
+    }
+
+    ~TokenBuffer();
+
+    // Copies build a line index of their own on first use, while moves take it along.
+    TokenBuffer(const TokenBuffer& other);
+    TokenBuffer(TokenBuffer&& other) noexcept;
+    auto operator=(const TokenBuffer& other) -> TokenBuffer&;
+    auto operator=(TokenBuffer&& other) noexcept -> TokenBuffer&;
+
+    auto reserve(usize capacity) -> void;
+    auto push(TokenType type, usize offset, usize length) -> void;
+    auto push(const CompactToken& token) -> void { push(token.type, token.offset, token.length); }
+
+    // Appends the tokens of another buffer starting at the given index, moving their offsets by
+    // `shift` bytes when the other buffer was lexed from an earlier revision of the source.
+    auto append(const TokenBuffer& other, usize from = 0, isize shift = 0) -> void;
+
+    [[nodiscard]] auto source() const noexcept -> std::string_view { return source_; }
+    [[nodiscard]] auto size() const noexcept -> usize { return types_.size(); }
+    [[nodiscard]] auto empty() const noexcept -> bool { return types_.empty(); }
+
+    [[nodiscard]] auto types() const noexcept -> std::span<const TokenType> { return types_; }
+    [[nodiscard]] auto offsets() const noexcept -> std::span<const u32> { return offsets_; }
+    [[nodiscard]] auto lengths() const noexcept -> std::span<const u32> { return lengths_; }
+
+    [[nodiscard]] auto type(usize idx) const noexcept -> TokenType { return types_[idx]; }
+    [[nodiscard]] auto slice(usize idx) const noexcept -> std::string_view {
+        return source_.substr(offsets_[idx], lengths_[idx]);
+    }
+    [[nodiscard]] auto compact(usize idx) const noexcept -> CompactToken {
+        return {offsets_[idx], lengths_[idx], types_[idx]};
+    }
+
+    // Materializes a full token, building the line index on first use. Buffers can be read from
+    // several threads at once, which race to build the index with only one of them keeping it.
+    [[nodiscard]] auto operator[](usize idx) const -> Token;
+    [[nodiscard]] auto front() const -> Token { return (*this)[0]; }
+    [[nodiscard]] auto back() const -> Token { return (*this)[size() - 1]; }
+    [[nodiscard]] auto line_index() const -> const LineIndex&;
+
+    [[nodiscard]] auto begin() const noexcept -> Iterator { return Iterator{*this, 0}; }
+    [[nodiscard]] auto end() const noexcept -> Iterator { return Iterator{*this, size()}; }
+
+  private:
+    std::string_view       source_{};
+    std::vector<TokenType> types_;
+    std::vector<u32>       offsets_;
+    std::vector<u32>       lengths_;
+
+    mutable std::atomic<const LineIndex*> lines_{nullptr};
+};
+
+} // namespace conch
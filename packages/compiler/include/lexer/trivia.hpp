@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cassert>
+#include <string_view>
+#include <vector>
+
+#include "source_limits.hpp"
+#include "types.hpp"
+
+namespace conch {
+
+enum class TriviaKind : u8 {
+    WHITESPACE,
+    COMMENT,
+};
+
+// A run of whitespace, or a single comment including its leading '//'.
+struct TriviaPiece {
+    TriviaKind       kind;
+    std::string_view text;
+};
+
+// The whitespace and comments skipped before each token, indexed by token number.
+//
+// Only the bounds of each span are stored, and since every byte of the source is either trivia or
+// part of a lexeme, the spans and lexemes together reproduce the source byte for byte.
+class TriviaTable {
+  public:
+    TriviaTable() noexcept = default;
+    explicit TriviaTable(std::string_view source) noexcept : source_{source} {}
+
+    auto clear() noexcept -> void { spans_.clear(); }
+    auto push(usize from, usize to) -> void {
+        assert(from <= to && to <= MAX_SOURCE_SIZE);
+        spans_.push_back({static_cast<u32>(from), static_cast<u32>(to)});
+    }
+
+    [[nodiscard]] auto source() const noexcept -> std::string_view { return source_; }
+    [[nodiscard]] auto size() const noexcept -> usize { return spans_.size(); }
+    [[nodiscard]] auto empty() const noexcept -> bool { return spans_.empty(); }
+
+    // The trivia before the token.
+    [[nodiscard]] auto leading(usize idx) const noexcept -> std::string_view {
+        return source_.substr(spans_[idx].from, spans_[idx].to - spans_[idx].from);
+    }
+
+    // Every byte of the token, running up to the trivia of the next one. Unlike token slices this
+    // includes the opening operator of multiline strings.
+    [[nodiscard]] auto lexeme(usize idx) const noexcept -> std::string_view;
+
+    // Splits the trivia before the token into whitespace runs and comments.
+    [[nodiscard]] auto pieces(usize idx) const -> std::vector<TriviaPiece>;
+
+  private:
+    struct Span {
+        u32 from;
+        u32 to;
+    };
+
+  private:
+    std::string_view  source_{};
+    std::vector<Span> spans_;
+};
+
+} // namespace conch
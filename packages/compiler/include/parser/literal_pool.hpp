@@ -0,0 +1,42 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+#include "types.hpp"
+
+namespace conch {
+
+// Interns string literal values that could not be viewed straight from the source.
+//
+// Each distinct value is stored once at an address that stays stable for the lifetime of the
+// pool, so equal literals share storage and can later be merged into a single constant. Interning
+// is thread safe, so parsers working on one compilation in parallel can share a pool.
+class LiteralPool {
+  public:
+    [[nodiscard]] auto intern(std::string_view literal) -> std::string_view;
+    [[nodiscard]] auto intern(std::string&& literal) -> std::string_view;
+
+    [[nodiscard]] auto contains(std::string_view literal) const -> bool {
+        const std::scoped_lock lock{mutex_};
+        return interned_.contains(literal);
+    }
+    [[nodiscard]] auto size() const -> usize {
+        const std::scoped_lock lock{mutex_};
+        return interned_.size();
+    }
+
+  private:
+    // Stores a literal that is known not to be interned yet, assuming the lock is held.
+    auto store(std::string&& literal) -> std::string_view;
+
+  private:
+    mutable std::mutex                   mutex_;
+    std::deque<std::string>              storage_;
+    std::unordered_set<std::string_view> interned_;
+};
+
+} // namespace conch
@@ -1,24 +1,134 @@
 #pragma once
 
+#include <algorithm>
+#include <iterator>
+#include <span>
+#include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
 
+#include "arena.hpp"
+#include "diagnostic.hpp"
 #include "memory.hpp"
 
+#include "parser/literal_pool.hpp"
 #include "parser/precedence.hpp"
 
+#include "lexer/integer_table.hpp"
 #include "lexer/lexer.hpp"
 #include "lexer/token.hpp"
 
+namespace conch {
+
+enum class ParserError : u8;
+class DeferredSource;
+
+} // namespace conch
+
 namespace conch::ast {
 
 class Node;
 class Statement;
 class Expression;
+class FlatAST;
+struct TokenShift;
+
+// The top level nodes of a parse, sharing ownership of the arena every node was carved from.
+//
+// Reading a tree is not thread-safe even through const references. Deferred function bodies are
+// parsed into the shared arena the first time they are read, so a tree must only be used from
+// one thread at a time.
+class AST {
+  public:
+    // The token indices a top level statement was parsed across. It begins at the cursor before
+    // any semicolons leading up to it, ends at the cursor after it, and depends on every token up
+    // to and including its lookahead.
+    struct Extent {
+        usize begin{0};
+        usize end{0};
+        usize lookahead{0};
+
+        auto operator==(const Extent&) const noexcept -> bool = default;
+    };
+
+  public:
+    AST() noexcept = default;
+    explicit AST(Rc<Arena> arena) noexcept : arena_{std::move(arena)} {}
+
+    template <typename... Args> auto emplace_back(Args&&... args) -> Box<Node>& {
+        return nodes_.emplace_back(std::forward<Args>(args)...);
+    }
+
+    // Appends a top level statement along with the tokens it was parsed from.
+    auto push_back(Box<Node> node, const Extent& extent) -> void {
+        nodes_.push_back(std::move(node));
+        extents_.push_back(extent);
+    }
+
+    [[nodiscard]] auto size() const noexcept -> usize { return nodes_.size(); }
+    [[nodiscard]] auto empty() const noexcept -> bool { return nodes_.empty(); }
+
+    auto operator[](usize idx) noexcept -> Box<Node>& { return nodes_[idx]; }
+    auto operator[](usize idx) const noexcept -> const Box<Node>& { return nodes_[idx]; }
+
+    auto begin() noexcept { return nodes_.begin(); }
+    auto end() noexcept { return nodes_.end(); }
+    auto begin() const noexcept { return nodes_.begin(); }
+    auto end() const noexcept { return nodes_.end(); }
+
+    [[nodiscard]] auto arena() const noexcept -> const Rc<Arena>& { return arena_; }
+
+    // The extents of every top level statement, unless the tree was not built by a parser.
+    [[nodiscard]] auto extents() const noexcept -> std::span<const Extent> { return extents_; }
+
+    // Keeps state the nodes point into alive for as long as the tree is.
+    auto retain(Rc<const void> state) -> void { retained_.push_back(std::move(state)); }
+
+    // Keeps the source of deferred function bodies alive. A source is only kept once however many
+    // times it is retained.
+    auto retain_deferred(Rc<const DeferredSource> source) -> void {
+        if (std::ranges::find(deferred_, source) != deferred_.end()) { return; }
+        deferred_.push_back(std::move(source));
+    }
+
+    // Moves the nodes of another tree onto the end of this one, keeping its arenas alive.
+    auto append(AST&& other) -> void {
+        nodes_.insert(nodes_.end(),
+                      std::make_move_iterator(other.nodes_.begin()),
+                      std::make_move_iterator(other.nodes_.end()));
+        extents_.insert(extents_.end(), other.extents_.begin(), other.extents_.end());
+        for (auto& source : other.deferred_) { retain_deferred(std::move(source)); }
+        other.deferred_.clear();
+        adopt(std::move(other));
+    }
 
-using AST = std::vector<Box<Node>>;
+    // Drops whatever nodes are left in another tree, keeping its arenas and deferred sources alive
+    // for the nodes that were moved out of it.
+    auto adopt(AST&& other) -> void {
+        other.nodes_.clear();
+        other.extents_.clear();
+        if (other.arena_) { retained_.push_back(std::move(other.arena_)); }
+        retained_.insert(retained_.end(),
+                         std::make_move_iterator(other.retained_.begin()),
+                         std::make_move_iterator(other.retained_.end()));
+        other.retained_.clear();
+        retained_.insert(retained_.end(),
+                         std::make_move_iterator(other.deferred_.begin()),
+                         std::make_move_iterator(other.deferred_.end()));
+        other.deferred_.clear();
+    }
+
+  private:
+    // Declared first so the nodes are dropped before the memory they live in
+    Rc<Arena>                             arena_;
+    std::vector<Rc<const void>>           retained_;
+    std::vector<Rc<const DeferredSource>> deferred_;
+    std::vector<Box<Node>>                nodes_;
+    std::vector<Extent>                   extents_;
+};
 
 } // namespace conch::ast
 
@@ -85,15 +195,95 @@ enum class ParserError : u8 {
     EMPTY_UNION,
     ILLEGAL_DEFERRED_STATEMENT,
     DEFER_MISSING_DEFERREE,
+    NESTING_LIMIT_EXCEEDED,
 };
 
 using ParserDiagnostic = Diagnostic<ParserError>;
 
+// Diagnostics built from a DiagnosticMessage borrow the token slices passed to it, so they can only
+// be read while the parsed source is alive. Keep to_string's result to report them past that.
 template <typename... Args>
 auto make_parser_unexpected(Args&&... args) -> Unexpected<ParserDiagnostic> {
     return Unexpected<ParserDiagnostic>{ParserDiagnostic{std::forward<Args>(args)...}};
 }
 
+struct ParallelParseOptions {
+    // The number of workers to parse with, where zero uses the hardware concurrency.
+    usize threads{0};
+
+    // Top level statements are batched into tasks spanning at least this many tokens, so small
+    // files are parsed serially.
+    usize min_task_tokens{usize{1} << 12};
+};
+
+struct ParserOptions {
+    // Skips over function bodies by matching braces, parsing each one the first time it is read.
+    bool lazy_function_bodies{false};
+
+    // Expressions and statements nested deeper than this are rejected with a diagnostic instead
+    // of exhausting the stack on machine generated input.
+    usize max_nesting_depth{256};
+
+    // Remembers where speculative rules failed and where they left the cursor. Input that nests
+    // something parsed once as an expression and again as a type then costs linear time instead of
+    // doubling with every level.
+    bool memoize_speculation{false};
+
+    // Collects runs of one binary operator into a single chain node with a flat operand list, so
+    // long generated chains neither allocate a node per operator nor nest as deep as they are long.
+    bool flatten_binary_chains{false};
+};
+
+// The rules that are attempted and given up on when they fail to parse.
+enum class SpeculativeRule : u8 {
+    CALL_ARGUMENT,
+    EXPLICIT_TYPE,
+};
+
+// The lexed form of an input, shared by every parser reading it.
+struct TokenStream {
+    std::string_view   source;
+    std::vector<Token> tokens;
+    IntegerTable       integers;
+
+    [[nodiscard]] auto offset(const Token& token) const noexcept -> usize {
+        return static_cast<usize>(token.slice.data() - source.data());
+    }
+};
+
+// Everything needed to resume parsing inside of an input after the parse that skipped over part
+// of it has finished. Trees holding deferred ranges retain their source.
+class DeferredSource {
+  public:
+    DeferredSource(Rc<const TokenStream> stream,
+                   Rc<LiteralPool>       literals,
+                   Rc<Arena>             arena,
+                   ParserOptions         options) noexcept
+        : stream{std::move(stream)}, literals{std::move(literals)}, arena{std::move(arena)},
+          options{options} {}
+
+  public:
+    Rc<const TokenStream> stream;
+    Rc<LiteralPool>       literals;
+    Rc<Arena>             arena;
+    ParserOptions         options;
+};
+
+// A skipped block from its opening to its closing brace, nested as deep as the parse was when it
+// skipped it. Nodes live in arenas that never run their destructors, so they point at the source
+// rather than sharing it.
+struct DeferredRange {
+    const DeferredSource* source{nullptr};
+    usize                 begin{0};
+    usize                 end{0};
+    usize                 depth{0};
+
+    // The tokens of the block, braces included.
+    [[nodiscard]] auto tokens() const noexcept -> std::span<const Token> {
+        return std::span{source->stream->tokens}.subspan(begin, end - begin + 1);
+    }
+};
+
 class Parser {
   public:
     using Diagnostics = std::vector<ParserDiagnostic>;
@@ -101,14 +291,13 @@ class Parser {
     using InfixFn     = Expected<Box<ast::Expression>, ParserDiagnostic> (*)(Parser&,
                                                                          Box<ast::Expression>);
 
+    // A position in the token array, so rolling back never lexes anything again.
     class Checkpoint {
       public:
-        explicit Checkpoint(const Parser& p) noexcept;
+        explicit Checkpoint(const Parser& p) noexcept : cursor_{p.cursor_} {}
 
       private:
-        Lexer::Snapshot snapshot_;
-        Token           current_;
-        Token           peek_;
+        usize cursor_;
 
         friend class Parser;
     };
@@ -132,21 +321,127 @@ class Parser {
 
   public:
     Parser() noexcept = default;
-    explicit Parser(std::string_view input) noexcept : input_{input}, lexer_{input} { advance(2); }
+    explicit Parser(std::string_view input) : input_{input} { tokenize(); }
+
+    // Creates a parser that interns materialized literals into a pool shared across a compilation.
+    explicit Parser(std::string_view input, Rc<LiteralPool> literals)
+        : input_{input}, literals_{std::move(literals)} {
+        tokenize();
+    }
+
+    explicit Parser(std::string_view     input,
+                    const ParserOptions& options,
+                    Rc<LiteralPool>      literals = {})
+        : input_{input}, literals_{std::move(literals)}, options_{options} {
+        tokenize();
+    }
+
+    // Creates a parser that shares ownership of its input with every tree it produces.
+    explicit Parser(Rc<const std::string> input,
+                    const ParserOptions&  options  = {},
+                    Rc<LiteralPool>       literals = {})
+        : input_{*input}, owned_input_{std::move(input)}, literals_{std::move(literals)},
+          options_{options} {
+        tokenize();
+    }
 
-    auto reset(std::string_view input = {}) noexcept -> void;
+    // Resumes parsing at a block skipped by a finished parse, allocating into its arena. The block
+    // counts against the nesting limit from the depth it was skipped at.
+    explicit Parser(const DeferredRange& range);
+
+    // Resets the parser to the new input, keeping its options and literal pool across the reset.
+    auto reset(std::string_view input = {}) -> void;
+    auto reset(Rc<const std::string> input) -> void;
 
     // Advances the parser, returning the resulting current token.
     // This is a no-op at end of stream.
     auto advance(uint8_t times = 1) noexcept -> const Token&;
     auto consume() -> std::pair<ast::AST, Diagnostics>;
 
+    // Parses top level statements on worker threads, producing exactly what consume would.
+    //
+    // Statement boundaries are guessed from semicolons outside of any brackets. Workers claim
+    // batches of statements as they free up, and a batch that an earlier statement ran into is
+    // parsed again serially from where that statement actually ended.
+    auto consume_parallel(const ParallelParseOptions& options = {})
+        -> std::pair<ast::AST, Diagnostics>;
+
+    // Parses the current input, which must be the result of applying the edit to the source that
+    // `previous` was parsed from as `previous_stream`.
+    //
+    // Top level statements are moved over from the previous tree when every token they looked at
+    // came before the edit, or shifted along with the text after it. A statement the edit fell
+    // inside of keeps everything outside of the innermost block around the edit, and only that
+    // block's statements are parsed again. A skipped function body around the edit is not parsed
+    // at all. Everything else in between is parsed again, so the result matches what consume would
+    // produce.
+    //
+    // The previous tree is consumed. Its reused nodes are changed in place and moved into the
+    // returned tree, so nothing else may still be reading them. Reused tokens are moved to their
+    // place in the current input, but string literals still view the previous source. The tree
+    // keeps the arenas of every tree it reused nodes from along with the inputs they owned, so a
+    // previous source that was passed as an owned input lives as long as the new tree. A borrowed
+    // one must outlive it instead.
+    auto reparse(ast::AST&& previous, const TokenStream& previous_stream, const TextEdit& edit)
+        -> std::pair<ast::AST, Diagnostics>;
+
+    // Converts the result of consume into the index-based form, dropping the pointer tree. This is
+    // a conversion utility rather than a faster parse: it does all of consume's work and lowers the
+    // tree on top of it, so it only pays off for passes that walk the flat form many times.
+    //
+    // The flat tree's tokens view the input, which has to outlive it. Deferred bodies are all read
+    // while lowering, so their failures are returned after the other diagnostics.
+    auto consume_flat() -> std::pair<ast::FlatAST, Diagnostics>;
+
+    [[nodiscard]] auto options() const noexcept -> const ParserOptions& { return options_; }
+    [[nodiscard]] auto token_stream() const noexcept -> const Rc<const TokenStream>& {
+        return stream_;
+    }
+
     auto current_token() const noexcept -> const Token& { return current_token_; }
     auto peek_token() const noexcept -> const Token& { return peek_token_; }
 
+    // How many statements and nested rules the cursor is inside of.
+    [[nodiscard]] auto depth() const noexcept -> usize { return depth_; }
+
+    // Returns the value the lexer decoded for an integer literal token while scanning it.
+    [[nodiscard]] auto integer_value(const Token& token) const noexcept
+        -> Optional<IntegerLiteral> {
+        return stream_->integers.find(static_cast<usize>(token.slice.data() - input_.data()));
+    }
+
+    // Stores a literal value that does not exist verbatim in the source. The returned view lives
+    // as long as the literal pool, which callers must keep alive alongside the AST.
+    [[nodiscard]] auto intern(std::string&& literal) -> std::string_view;
+    [[nodiscard]] auto literals() -> const Rc<LiteralPool>&;
+
+    // Allocates AST storage from the parser's arena. Each call to consume starts a fresh arena
+    // that the returned AST shares, so the tree stays valid after the parser moves on. Destructors
+    // of arena values never run, so nothing allocated here may own heap memory.
+    [[nodiscard]] auto arena() -> const Rc<Arena>&;
+    [[nodiscard]] auto allocator() -> ArenaAllocator<byte> { return arena().get(); }
+
+    template <typename T, typename... Args> [[nodiscard]] auto make_box(Args&&... args) -> Box<T> {
+        return make_arena_box<T>(*arena(), std::forward<Args>(args)...);
+    }
+
     auto current_token_is(TokenType t) const noexcept -> bool { return current_token_.type == t; }
     auto peek_token_is(TokenType t) const noexcept -> bool { return peek_token_.type == t; }
 
+    // Skips from the opening brace at the cursor to its matching closing brace, returning the range
+    // to parse later. Unbalanced braces return nothing and leave the cursor where it was.
+    [[nodiscard]] auto defer_block() -> Optional<DeferredRange>;
+
+    // Runs a speculative rule at the cursor, replaying its failure if it already failed there.
+    // Successes are not cached since their nodes are moved into whichever tree accepted them.
+    template <typename T, typename F>
+    [[nodiscard]] auto memoize(SpeculativeRule rule, F&& parse) -> Expected<T, ParserDiagnostic>;
+
+    // Runs a rule that recurses outside of the statement and operator parsers one level deeper,
+    // failing once the nesting limit has been reached. The depth is restored however it exits.
+    template <typename T, typename F>
+    [[nodiscard]] auto nested(F&& parse) -> Expected<T, ParserDiagnostic>;
+
     // Advances the cursor tokens only if the expected token type matches the actual peek token.
     [[nodiscard]] auto expect_peek(TokenType expected)
         -> Expected<std::monostate, ParserDiagnostic>;
@@ -178,18 +473,123 @@ class Parser {
   private:
     static auto tt_mismatch_error(TokenType expected, const Token& actual) -> ParserDiagnostic;
 
+    // Lexes the whole input up front and moves to its first token.
+    auto tokenize() -> void;
+
+    // Moves back to the first token so the same tokens can be parsed again into a fresh arena.
+    auto rewind() -> void;
+
+    // Keeps the owned input and the source of skipped bodies alive for as long as the tree is.
+    auto retain_sources(ast::AST& ast) const -> void;
+
+    // Creates a parser that reads this parser's tokens and shares its literal pool, but allocates
+    // from an arena of its own.
+    [[nodiscard]] auto fork() -> Parser;
+
+    // The source that blocks skipped by this parser resume from, created on first use.
+    [[nodiscard]] auto deferred_source() -> const DeferredSource&;
+
+    // Parses the statement at the cursor along with any semicolons before it, recovering past the
+    // end of the statement on failure.
+    auto parse_top_level(ast::AST& ast, Diagnostics& diagnostics) -> void;
+
+    // Parses the innermost block of a previous statement that the edit fell inside of again,
+    // splicing it into the statement and moving the rest of the statement along with the edit.
+    // Returns the last token the statement now depends on, or nothing when it has to be parsed
+    // again whole, in which case the statement is left untouched.
+    [[nodiscard]] auto reparse_block(const ast::Node&        statement,
+                                     const TokenStream&      previous_stream,
+                                     const ast::AST::Extent& extent,
+                                     usize                   prefix,
+                                     const ast::TokenShift&  shift) -> Optional<usize>;
+
+    // Parses an expression, folding unary, binary and grouped operators against a stack of its own
+    // rather than recursing through their parse functions.
+    [[nodiscard]] auto parse_operators(Precedence precedence)
+        -> Expected<Box<ast::Expression>, ParserDiagnostic>;
+
+    // Enters one more level of nesting, failing once the limit has been reached.
+    [[nodiscard]] auto nest() -> Expected<std::monostate, ParserDiagnostic>;
+
+    // Loads the current and peek tokens from the cursor, which never moves past the end token.
+    // The furthest token peeked at is tracked so statements know what they depend on.
+    auto sync() noexcept -> void {
+        const auto& tokens = stream_->tokens;
+        const auto  last   = tokens.size() - 1;
+        const auto  peek   = std::min(cursor_ + 1, last);
+        current_token_     = tokens[cursor_];
+        peek_token_        = tokens[peek];
+        lookahead_         = std::max(lookahead_, peek);
+    }
+
     // Reverts the parser to the state from the checkpoint.
     auto rollback(const Checkpoint& checkpoint) noexcept -> void {
-        lexer_.restore(checkpoint.snapshot_);
-        current_token_ = checkpoint.current_;
-        peek_token_    = checkpoint.peek_;
+        cursor_ = checkpoint.cursor_;
+        sync();
     }
 
   private:
-    std::string_view input_;
-    Lexer            lexer_{};
-    Token            current_token_{};
-    Token            peek_token_{};
+    // A failed speculative parse, replayed only at depths where it could not have hit the limit.
+    struct MemoEntry {
+        ParserDiagnostic error;
+        Checkpoint       resume;
+        usize            lookahead;
+        usize            depth;
+    };
+
+  private:
+    std::string_view      input_;
+    Rc<const std::string> owned_input_{};
+    Rc<const TokenStream> stream_{};
+    usize                 cursor_{0};
+    usize                 lookahead_{0};
+    usize                 depth_{0};
+    Token                 current_token_{};
+    Token                 peek_token_{};
+    Rc<LiteralPool>       literals_{};
+    Rc<Arena>             arena_{};
+    ParserOptions         options_{};
+    Rc<DeferredSource>    deferred_{};
+    const DeferredSource* resumed_{nullptr};
+
+    std::unordered_map<usize, MemoEntry> memo_{};
 };
 
+template <typename T, typename F>
+auto Parser::memoize(SpeculativeRule rule, F&& parse) -> Expected<T, ParserDiagnostic> {
+    if (!options_.memoize_speculation) { return std::forward<F>(parse)(); }
+
+    // Rules are a byte wide, so they fill the low byte of the key under the token index
+    const auto key = (cursor_ << 8) | static_cast<usize>(rule);
+    if (const auto it = memo_.find(key); it != memo_.end() && depth_ <= it->second.depth) {
+        const auto& entry = it->second;
+        rollback(entry.resume);
+        lookahead_ = std::max(lookahead_, entry.lookahead);
+        return Unexpected{entry.error};
+    }
+
+    // Lookahead is tracked from scratch so the entry only records what the rule itself peeked at
+    const auto outer_lookahead = lookahead_;
+    const auto depth           = depth_;
+    lookahead_                 = cursor_;
+
+    Expected<T, ParserDiagnostic> result = std::forward<F>(parse)();
+    const auto                    inner  = lookahead_;
+    lookahead_                           = std::max(outer_lookahead, inner);
+
+    // Hitting the nesting limit depends on the depth the rule started at, not just its tokens
+    if (!result && result.error().error() != ParserError::NESTING_LIMIT_EXCEEDED) {
+        memo_.insert_or_assign(key, MemoEntry{result.error(), Checkpoint{*this}, inner, depth});
+    }
+    return result;
+}
+
+template <typename T, typename F> auto Parser::nested(F&& parse) -> Expected<T, ParserDiagnostic> {
+    const auto depth = depth_;
+    TRY(nest());
+    Expected<T, ParserDiagnostic> result = std::forward<F>(parse)();
+    depth_                               = depth;
+    return result;
+}
+
 } // namespace conch
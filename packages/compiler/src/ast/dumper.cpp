@@ -211,7 +211,11 @@ auto ASTDumper::visit(const FunctionExpression& node) -> void {
     if (node.has_body()) {
         const Indent::Guard g{indent_, true};
         fmt::print(out_, "{}Body: ", indent_.current_branch());
-        node.get_body().accept(*this);
+        if (const auto loaded = node.load_body(); !loaded) {
+            fmt::println(out_, "Unparsed ({})", loaded.error());
+        } else {
+            node.get_body().accept(*this);
+        }
     }
 }
 
@@ -267,6 +271,13 @@ auto ASTDumper::visit(const InfiniteLoopExpression& node) -> void {
 
 MAKE_INFIX_DUMP(AssignmentExpression, Assignee, Value)
 MAKE_INFIX_DUMP(BinaryExpression, LHS, RHS)
+
+auto ASTDumper::visit(const BinaryChainExpression& node) -> void {
+    fmt::println(out_, "BinaryChainExpression ({})", magic_enum::enum_name(node.get_op()));
+    const Indent::Guard g{indent_, true};
+    fmt::println(out_, "{}Operands:", indent_.current_branch());
+    dump_node_list(node.get_operands());
+}
 MAKE_INFIX_DUMP(DotExpression, Object, Member)
 MAKE_INFIX_DUMP(RangeExpression, Lower, Upper)
 MAKE_INFIX_DUMP(ImplicitDereferenceExpression, Object, Member)
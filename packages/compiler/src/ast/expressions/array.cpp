@@ -12,7 +12,7 @@ namespace conch::ast {
 ArrayExpression::ArrayExpression(const Token&                 start_token,
                                  Optional<Box<Expression>>    size,
                                  ExplicitType&&               item_type,
-                                 std::vector<Box<Expression>> items) noexcept
+                                 ArenaVector<Box<Expression>> items) noexcept
     : ExprBase{start_token}, size_{std::move(size)}, item_type_{std::move(item_type)},
       items_{std::move(items)} {}
 ArrayExpression::~ArrayExpression() = default;
@@ -37,7 +37,7 @@ auto ArrayExpression::parse(Parser& parser) -> Expected<Box<Expression>, ParserD
     TRY(parser.expect_peek(TokenType::LBRACE));
 
     // Current token is either the LBRACE at the start or a comma before parsing
-    std::vector<Box<Expression>> items;
+    ArenaVector<Box<Expression>> items{parser.allocator()};
     while (!parser.peek_token_is(TokenType::RBRACE) && !parser.peek_token_is(TokenType::END)) {
         parser.advance();
         items.emplace_back(TRY(parser.parse_expression()));
@@ -63,7 +63,7 @@ auto ArrayExpression::parse(Parser& parser) -> Expected<Box<Expression>, ParserD
         }
     }
 
-    return make_box<ArrayExpression>(
+    return parser.make_box<ArrayExpression>(
         start_token, std::move(size), std::move(item_type), std::move(items));
 }
 
@@ -27,7 +27,7 @@ auto CallArgument::is_equal(const CallArgument& other) const noexcept -> bool {
 
 CallExpression::CallExpression(const Token&              start_token,
                                Box<Expression>           function,
-                               std::vector<CallArgument> arguments) noexcept
+                               ArenaVector<CallArgument> arguments) noexcept
     : ExprBase{start_token}, function_{std::move(function)}, arguments_{std::move(arguments)} {}
 CallExpression::~CallExpression() = default;
 
@@ -35,17 +35,25 @@ auto CallExpression::accept(Visitor& v) const -> void { v.visit(*this); }
 
 auto CallExpression::parse(Parser& parser, Box<Expression> function)
     -> Expected<Box<Expression>, ParserDiagnostic> {
-    std::vector<CallArgument> arguments;
+    ArenaVector<CallArgument> arguments{parser.allocator()};
     // Guaranteed to roll back if there is an error
-    const auto parse_expr_unsuccessful = [&]() {
+    const auto parse_expr_unsuccessful = [&]() -> Expected<bool, ParserDiagnostic> {
         // Try an expression first to prevent ambiguity between reference operators
         Parser::Transaction transaction{parser};
-        parser.advance();
-        if (auto expr = parser.parse_expression()) {
+        auto expr = parser.memoize<Box<Expression>>(SpeculativeRule::CALL_ARGUMENT, [&] {
+            parser.advance();
+            return parser.parse_expression();
+        });
+        if (expr) {
             transaction.commit();
             arguments.emplace_back(std::move(*expr));
             return false;
         }
+
+        // A type would nest just as deep, so there is no point in trying one
+        if (expr.error().error() == ParserError::NESTING_LIMIT_EXCEEDED) {
+            return Unexpected{std::move(expr.error())};
+        }
         return true;
     };
 
@@ -56,12 +64,14 @@ auto CallExpression::parse(Parser& parser, Box<Expression> function)
         }
 
         // Advance cannot be called here since explicit type relies on peek, not current
-        if (parse_expr_unsuccessful()) { arguments.emplace_back(TRY(ExplicitType::parse(parser))); }
+        if (TRY(parse_expr_unsuccessful())) {
+            arguments.emplace_back(TRY(ExplicitType::parse(parser)));
+        }
         if (!parser.peek_token_is(TokenType::RPAREN)) { TRY(parser.expect_peek(TokenType::COMMA)); }
     }
     TRY(parser.expect_peek(TokenType::RPAREN));
 
-    return make_box<CallExpression>(
+    return parser.make_box<CallExpression>(
         function->get_token(), std::move(function), std::move(arguments));
 }
 
@@ -32,7 +32,8 @@ auto DoWhileLoopExpression::parse(Parser& parser) -> Expected<Box<Expression>, P
     if (block->empty()) {
         return make_parser_unexpected(ParserError::EMPTY_LOOP, block->get_token());
     }
-    return make_box<DoWhileLoopExpression>(start_token, std::move(block), std::move(condition));
+    return parser.make_box<DoWhileLoopExpression>(
+        start_token, std::move(block), std::move(condition));
 }
 
 auto DoWhileLoopExpression::is_equal(const Node& other) const noexcept -> bool {
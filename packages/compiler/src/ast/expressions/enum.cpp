@@ -17,7 +17,7 @@ auto Enumeration::is_equal(const Enumeration& other) const noexcept -> bool {
 
 EnumExpression::EnumExpression(const Token&                        start_token,
                                Optional<Box<IdentifierExpression>> underlying,
-                               std::vector<Enumeration>            enumerations) noexcept
+                               ArenaVector<Enumeration>            enumerations) noexcept
     : ExprBase{start_token}, underlying_{std::move(underlying)},
       enumerations_{std::move(enumerations)} {}
 EnumExpression::~EnumExpression() = default;
@@ -41,7 +41,7 @@ auto EnumExpression::parse(Parser& parser) -> Expected<Box<Expression>, ParserDi
         return make_parser_unexpected(ParserError::ENUM_MISSING_VARIANTS, opening);
     }
 
-    std::vector<Enumeration> enumeration;
+    ArenaVector<Enumeration> enumeration{parser.allocator()};
     while (!parser.peek_token_is(TokenType::RBRACE) && !parser.peek_token_is(TokenType::END)) {
         TRY(parser.expect_peek(TokenType::IDENT));
         auto ident = downcast<IdentifierExpression>(TRY(IdentifierExpression::parse(parser)));
@@ -57,7 +57,8 @@ auto EnumExpression::parse(Parser& parser) -> Expected<Box<Expression>, ParserDi
     }
 
     TRY(parser.expect_peek(TokenType::RBRACE));
-    return make_box<EnumExpression>(start_token, std::move(underlying), std::move(enumeration));
+    return parser.make_box<EnumExpression>(
+        start_token, std::move(underlying), std::move(enumeration));
 }
 
 auto EnumExpression::is_equal(const Node& other) const noexcept -> bool {
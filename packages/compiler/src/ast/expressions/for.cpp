@@ -26,8 +26,8 @@ auto ForLoopCapture::is_equal(const ForLoopCapture& other) const noexcept -> boo
 }
 
 ForLoopExpression::ForLoopExpression(const Token&                 start_token,
-                                     std::vector<Box<Expression>> iterables,
-                                     std::vector<ForLoopCapture>  captures,
+                                     ArenaVector<Box<Expression>> iterables,
+                                     ArenaVector<ForLoopCapture>  captures,
                                      Box<BlockStatement>          block,
                                      Optional<Box<Statement>>     non_break) noexcept
     : ExprBase{start_token}, iterables_{std::move(iterables)}, captures_{std::move(captures)},
@@ -46,7 +46,7 @@ auto ForLoopExpression::parse(Parser& parser) -> Expected<Box<Expression>, Parse
         return make_parser_unexpected(ParserError::FOR_MISSING_ITERABLES, start_token);
     }
 
-    std::vector<Box<Expression>> iterables;
+    ArenaVector<Box<Expression>> iterables{parser.allocator()};
     while (!parser.peek_token_is(TokenType::RPAREN) && !parser.peek_token_is(TokenType::END)) {
         parser.advance();
 
@@ -59,7 +59,7 @@ auto ForLoopExpression::parse(Parser& parser) -> Expected<Box<Expression>, Parse
     TRY(parser.expect_peek(TokenType::RPAREN));
 
     // Captures take on something similar to zig's capture syntax
-    std::vector<ForLoopCapture> captures;
+    ArenaVector<ForLoopCapture> captures{parser.allocator()};
     TRY(parser.expect_peek(TokenType::BW_OR));
     while (!parser.peek_token_is(TokenType::BW_OR) && !parser.peek_token_is(TokenType::END)) {
         parser.advance();
@@ -93,11 +93,11 @@ auto ForLoopExpression::parse(Parser& parser) -> Expected<Box<Expression>, Parse
         return make_parser_unexpected(ParserError::EMPTY_FOR_LOOP, block->get_token());
     }
 
-    return make_box<ForLoopExpression>(start_token,
-                                       std::move(iterables),
-                                       std::move(captures),
-                                       std::move(block),
-                                       std::move(non_break));
+    return parser.make_box<ForLoopExpression>(start_token,
+                                              std::move(iterables),
+                                              std::move(captures),
+                                              std::move(block),
+                                              std::move(non_break));
 }
 
 auto ForLoopExpression::is_equal(const Node& other) const noexcept -> bool {
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cassert>
 
 #include "ast/expressions/function.hpp"
 
@@ -29,22 +30,44 @@ auto SelfParameter::is_equal(const SelfParameter& other) const noexcept -> bool
 
 FunctionExpression::FunctionExpression(const Token&                   start_token,
                                        Optional<SelfParameter>        self,
-                                       std::vector<FunctionParameter> parameters,
+                                       ArenaVector<FunctionParameter> parameters,
                                        ExplicitType&&                 return_type,
                                        Optional<Box<BlockStatement>>  body) noexcept
     : ExprBase{start_token}, self_{std::move(self)}, parameters_{std::move(parameters)},
       return_type_{std::move(return_type)}, body_{std::move(body)} {}
+
+FunctionExpression::FunctionExpression(const Token&                   start_token,
+                                       Optional<SelfParameter>        self,
+                                       ArenaVector<FunctionParameter> parameters,
+                                       ExplicitType&&                 return_type,
+                                       DeferredRange                  body) noexcept
+    : ExprBase{start_token}, self_{std::move(self)}, parameters_{std::move(parameters)},
+      return_type_{std::move(return_type)}, body_range_{body} {}
 FunctionExpression::~FunctionExpression() = default;
 
 auto FunctionExpression::accept(Visitor& v) const -> void { v.visit(*this); }
 
+auto FunctionExpression::get_body() const noexcept -> const BlockStatement& {
+    assert(body_);
+    return **body_;
+}
+
+auto FunctionExpression::load_body() const -> Expected<std::monostate, ParserDiagnostic> {
+    if (!body_range_.source) { return {}; }
+
+    Parser resumed{body_range_};
+    body_       = downcast<BlockStatement>(TRY(BlockStatement::parse(resumed)));
+    body_range_ = {};
+    return {};
+}
+
 auto FunctionExpression::parse(Parser& parser) -> Expected<Box<Expression>, ParserDiagnostic> {
     const auto start_token = parser.current_token();
     TRY(parser.expect_peek(TokenType::LPAREN));
 
     // Parse the definition now that we're at the fn token
     Optional<SelfParameter>        self;
-    std::vector<FunctionParameter> parameters;
+    ArenaVector<FunctionParameter> parameters{parser.allocator()};
     if (parser.peek_token_is(TokenType::RPAREN)) {
         parser.advance();
     } else {
@@ -111,18 +134,29 @@ auto FunctionExpression::parse(Parser& parser) -> Expected<Box<Expression>, Pars
 
     // If there is opening brace then just return without a body
     if (!parser.peek_token_is(TokenType::LBRACE)) {
-        return make_box<FunctionExpression>(
+        return parser.make_box<FunctionExpression>(
             start_token, std::move(self), std::move(parameters), std::move(return_type), nullopt);
     }
 
     // Otherwise there must be a well-formed block
     TRY(parser.expect_peek(TokenType::LBRACE));
+    if (parser.options().lazy_function_bodies) {
+        // The block is only brace matched for now, so its contents are checked when first read
+        if (const auto range = parser.defer_block()) {
+            return parser.make_box<FunctionExpression>(start_token,
+                                                       std::move(self),
+                                                       std::move(parameters),
+                                                       std::move(return_type),
+                                                       *range);
+        }
+    }
+
     auto body = downcast<BlockStatement>(TRY(BlockStatement::parse(parser)));
-    return make_box<FunctionExpression>(start_token,
-                                        std::move(self),
-                                        std::move(parameters),
-                                        std::move(return_type),
-                                        std::move(body));
+    return parser.make_box<FunctionExpression>(start_token,
+                                               std::move(self),
+                                               std::move(parameters),
+                                               std::move(return_type),
+                                               std::move(body));
 }
 
 auto FunctionExpression::is_equal(const Node& other) const noexcept -> bool {
@@ -130,7 +164,19 @@ auto FunctionExpression::is_equal(const Node& other) const noexcept -> bool {
     const auto  self_matches  = optional::safe_eq<SelfParameter>(self_, casted.self_);
     const auto  parameters_eq = std::ranges::equal(parameters_, casted.parameters_);
     return self_matches && parameters_eq && return_type_ == casted.return_type_ &&
-           optional::unsafe_eq<BlockStatement>(body_, casted.body_);
+           bodies_equal(casted);
+}
+
+// Comparing never parses, so a deferred body only equals another one skipped over the same tokens
+auto FunctionExpression::bodies_equal(const FunctionExpression& other) const noexcept -> bool {
+    if (has_body() != other.has_body()) { return false; }
+    if (!has_body()) { return true; }
+    if (is_body_deferred() || other.is_body_deferred()) {
+        return is_body_deferred() && other.is_body_deferred() &&
+               body_range_.depth == other.body_range_.depth &&
+               std::ranges::equal(body_range_.tokens(), other.body_range_.tokens());
+    }
+    return **body_ == **other.body_;
 }
 
 } // namespace conch::ast
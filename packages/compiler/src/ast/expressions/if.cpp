@@ -24,7 +24,7 @@ auto IfExpression::parse(Parser& parser) -> Expected<Box<Expression>, ParserDiag
     auto consequence = TRY(parser.parse_restricted_statement(ParserError::ILLEGAL_IF_BRANCH));
     auto alternate   = TRY(parser.try_parse_restricted_alternate(ParserError::ILLEGAL_IF_BRANCH));
 
-    return make_box<IfExpression>(
+    return parser.make_box<IfExpression>(
         start_token, std::move(condition), std::move(consequence), std::move(alternate));
 }
 
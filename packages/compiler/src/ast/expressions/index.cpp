@@ -16,7 +16,7 @@ auto IndexExpression::parse(Parser& parser, Box<Expression> array)
 
     auto idx_expr = TRY(parser.parse_expression());
     TRY(parser.expect_peek(TokenType::RBRACKET));
-    return make_box<IndexExpression>(start_token, std::move(array), std::move(idx_expr));
+    return parser.make_box<IndexExpression>(start_token, std::move(array), std::move(idx_expr));
 }
 
 } // namespace conch::ast
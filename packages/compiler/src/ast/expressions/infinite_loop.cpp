@@ -20,7 +20,7 @@ auto InfiniteLoopExpression::parse(Parser& parser) -> Expected<Box<Expression>,
     if (block->empty()) {
         return make_parser_unexpected(ParserError::EMPTY_LOOP, block->get_token());
     }
-    return make_box<InfiniteLoopExpression>(start_token, std::move(block));
+    return parser.make_box<InfiniteLoopExpression>(start_token, std::move(block));
 }
 
 auto InfiniteLoopExpression::is_equal(const Node& other) const noexcept -> bool {
@@ -0,0 +1,87 @@
+#include <algorithm>
+
+#include "ast/expressions/infix.hpp"
+
+#include "ast/visitor.hpp"
+
+namespace conch::ast {
+
+auto BinaryExpression::make(Parser&         parser,
+                            Box<Expression> lhs,
+                            TokenType       op,
+                            Box<Expression> rhs) -> Box<Expression> {
+    if (parser.options().flatten_binary_chains) {
+        return BinaryChainExpression::extend(parser, std::move(lhs), op, std::move(rhs));
+    }
+    return InfixExpression::make(parser, std::move(lhs), op, std::move(rhs));
+}
+
+BinaryChainExpression::BinaryChainExpression(const Token&                 start_token,
+                                             TokenType                    op,
+                                             ArenaVector<Box<Expression>> operands) noexcept
+    : ExprBase{start_token}, op_{op}, operands_{std::move(operands)} {}
+BinaryChainExpression::~BinaryChainExpression() = default;
+
+auto BinaryChainExpression::accept(Visitor& v) const -> void { v.visit(*this); }
+
+auto BinaryChainExpression::extend(Parser&         parser,
+                                   Box<Expression> lhs,
+                                   TokenType       op,
+                                   Box<Expression> rhs) -> Box<Expression> {
+    // Operators are left associative, so a run only ever grows along the left operand
+    if (lhs->is<BinaryChainExpression>() && as<BinaryChainExpression>(*lhs).op_ == op) {
+        auto chain = downcast<BinaryChainExpression>(std::move(lhs));
+        chain->operands_.emplace_back(std::move(rhs));
+        return chain;
+    }
+
+    if (lhs->is<BinaryExpression>() && as<BinaryExpression>(*lhs).op_ == op) {
+        auto                         binary = downcast<BinaryExpression>(std::move(lhs));
+        ArenaVector<Box<Expression>> operands{parser.allocator()};
+        operands.reserve(3);
+        operands.emplace_back(std::move(binary->lhs_));
+        operands.emplace_back(std::move(binary->rhs_));
+        operands.emplace_back(std::move(rhs));
+        return parser.make_box<BinaryChainExpression>(
+            binary->get_token(), op, std::move(operands));
+    }
+    return BinaryExpression::InfixExpression::make(parser, std::move(lhs), op, std::move(rhs));
+}
+
+auto BinaryChainExpression::is_equal(const Node& other) const noexcept -> bool {
+    const auto& casted = as<BinaryChainExpression>(other);
+    return op_ == casted.op_ &&
+           std::ranges::equal(
+               operands_, casted.operands_, [](const auto& a, const auto& b) { return *a == *b; });
+}
+
+auto BinarySpine::size() const noexcept -> usize { return chain_.get_operands().size() - 1; }
+
+auto BinarySpine::operator[](usize idx) const noexcept -> BinaryLink {
+    const auto operands = chain_.get_operands();
+    return {idx == 0 ? Optional<const Expression&>{*operands[0]} : nullopt,
+            chain_.get_op(),
+            *operands[idx + 1]};
+}
+
+auto BinarySpine::matches(const Expression& binaries) const noexcept -> bool {
+    // Every binary the parser builds for a run starts at the run's first operand
+    const auto&       start   = chain_.get_token();
+    const Expression* current = &binaries;
+    for (usize i = size(); i-- > 0;) {
+        if (!current->is<BinaryExpression>()) { return false; }
+        const auto& binary = Node::as<BinaryExpression>(*current);
+        const auto& token  = binary.get_token();
+        const auto  link   = (*this)[i];
+        if (token.type != start.type || token.slice != start.slice || binary.get_op() != link.op ||
+            binary.get_rhs() != link.rhs) {
+            return false;
+        }
+
+        if (link.lhs) { return binary.get_lhs() == *link.lhs; }
+        current = &binary.get_lhs();
+    }
+    return true;
+}
+
+} // namespace conch::ast
@@ -33,7 +33,7 @@ auto MatchArm::is_equal(const MatchArm& other) const noexcept -> bool {
 
 MatchExpression::MatchExpression(const Token&             start_token,
                                  Box<Expression>          matcher,
-                                 std::vector<MatchArm>    arms,
+                                 ArenaVector<MatchArm>    arms,
                                  Optional<Box<Statement>> catch_all) noexcept
     : ExprBase{start_token}, matcher_{std::move(matcher)}, arms_{std::move(arms)},
       catch_all_{std::move(catch_all)} {}
@@ -60,7 +60,7 @@ auto MatchExpression::parse(Parser& parser) -> Expected<Box<Expression>, ParserD
         return make_parser_unexpected(ParserError::ARMLESS_MATCH_EXPR, start_token);
     }
 
-    std::vector<MatchArm> arms;
+    ArenaVector<MatchArm> arms{parser.allocator()};
     // Current token is either the LBRACE at the start or a comma before parsing
     while (!parser.peek_token_is(TokenType::RBRACE) && !parser.peek_token_is(TokenType::END)) {
         parser.advance();
@@ -94,7 +94,7 @@ auto MatchExpression::parse(Parser& parser) -> Expected<Box<Expression>, ParserD
     auto catch_all =
         TRY(parser.try_parse_restricted_alternate(ParserError::ILLEGAL_MATCH_CATCH_ALL));
 
-    return make_box<MatchExpression>(
+    return parser.make_box<MatchExpression>(
         start_token, std::move(condition), std::move(arms), std::move(catch_all));
 }
 
@@ -12,10 +12,22 @@ auto StringExpression::accept(Visitor& v) const -> void { v.visit(*this); }
 
 auto StringExpression::parse(Parser& parser) -> Expected<Box<Expression>, ParserDiagnostic> {
     const auto start_token = parser.current_token();
-    const auto promoted    = start_token.promote();
+    const auto slice       = start_token.slice;
+
+    // Plain strings and single line multiline strings need no processing, so they view the source.
+    // A single line that starts with another line marker still has it stripped by promotion.
+    if (start_token.type == TokenType::STRING && slice.size() >= 2) {
+        return parser.make_box<StringExpression>(start_token, slice.substr(1, slice.size() - 2));
+    }
+    if (start_token.type == TokenType::MULTILINE_STRING && !slice.contains('\n') &&
+        !slice.starts_with("\\\\")) {
+        return parser.make_box<StringExpression>(start_token, slice);
+    }
+
+    auto promoted = start_token.promote();
     if (!promoted) { return make_parser_unexpected(ParserError::MALFORMED_STRING, start_token); }
 
-    return make_box<StringExpression>(start_token, *promoted);
+    return parser.make_box<StringExpression>(start_token, parser.intern(std::move(*promoted)));
 }
 
 auto SignedIntegerExpression::accept(Visitor& v) const -> void { v.visit(*this); }
@@ -30,7 +42,7 @@ auto ByteExpression::accept(Visitor& v) const -> void { v.visit(*this); }
 auto ByteExpression::parse(Parser& parser) -> Expected<Box<Expression>, ParserDiagnostic> {
     const auto start_token = parser.current_token();
     const auto slice       = start_token.slice;
-    if (slice[1] != '\\') { return make_box<ByteExpression>(start_token, slice[1]); }
+    if (slice[1] != '\\') { return parser.make_box<ByteExpression>(start_token, slice[1]); }
 
     const auto escaped = slice[2];
     byte       value;
@@ -45,7 +57,7 @@ auto ByteExpression::parse(Parser& parser) -> Expected<Box<Expression>, ParserDi
     default:   return make_parser_unexpected(ParserError::UNKNOWN_CHARACTER_ESCAPE, start_token);
     }
 
-    return make_box<ByteExpression>(start_token, value);
+    return parser.make_box<ByteExpression>(start_token, value);
 }
 
 template <typename T> auto approx_eq(T a, T b) -> bool {
@@ -72,7 +84,7 @@ auto BoolExpression::accept(Visitor& v) const -> void { v.visit(*this); }
 
 auto BoolExpression::parse(Parser& parser) -> Expected<Box<Expression>, ParserDiagnostic> {
     const auto& start_token = parser.current_token();
-    return make_box<BoolExpression>(start_token, start_token.type == TokenType::TRUE);
+    return parser.make_box<BoolExpression>(start_token, start_token.type == TokenType::TRUE);
 }
 
 // cppcheck-suppress-end [constParameterReference, duplInheritedMember]
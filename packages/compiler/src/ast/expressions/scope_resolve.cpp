@@ -21,7 +21,7 @@ auto ScopeResolutionExpression::parse(Parser& parser, Box<Expression> outer)
 
     TRY(parser.expect_peek(TokenType::IDENT));
     auto inner = downcast<IdentifierExpression>(TRY(IdentifierExpression::parse(parser)));
-    return make_box<ScopeResolutionExpression>(
+    return parser.make_box<ScopeResolutionExpression>(
         outer->get_token(), std::move(outer), std::move(inner));
 }
 
@@ -8,7 +8,7 @@
 namespace conch::ast {
 
 StructExpression::StructExpression(const Token&                    start_token,
-                                   std::vector<Box<DeclStatement>> members) noexcept
+                                   ArenaVector<Box<DeclStatement>> members) noexcept
     : ExprBase{start_token}, members_{std::move(members)} {}
 StructExpression::~StructExpression() = default;
 
@@ -22,7 +22,7 @@ auto StructExpression::parse(Parser& parser) -> Expected<Box<Expression>, Parser
         return make_parser_unexpected(ParserError::PACKED_AFTER_STRUCT_KEYWORD, start_token);
     }
 
-    std::vector<Box<DeclStatement>> members;
+    ArenaVector<Box<DeclStatement>> members{parser.allocator()};
     TRY(parser.expect_peek(TokenType::LBRACE));
     while (!parser.peek_token_is(TokenType::RBRACE)) {
         parser.advance();
@@ -36,7 +36,7 @@ auto StructExpression::parse(Parser& parser) -> Expected<Box<Expression>, Parser
 
     TRY(parser.expect_peek(TokenType::RBRACE));
     if (members.empty()) { return make_parser_unexpected(ParserError::EMPTY_STRUCT, start_token); }
-    return make_box<StructExpression>(start_token, std::move(members));
+    return parser.make_box<StructExpression>(start_token, std::move(members));
 }
 
 auto StructExpression::is_equal(const Node& other) const noexcept -> bool {
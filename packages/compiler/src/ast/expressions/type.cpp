@@ -43,6 +43,14 @@ auto ExplicitType::is_equal(const ExplicitType& other) const noexcept -> bool {
 }
 
 [[nodiscard]] auto ExplicitType::parse(Parser& parser) -> Expected<ExplicitType, ParserDiagnostic> {
+    // Array dimensions and modifiers recurse through here, so each one is a level of nesting
+    return parser.nested<ExplicitType>([&parser] {
+        return parser.memoize<ExplicitType>(SpeculativeRule::EXPLICIT_TYPE,
+                                            [&parser] { return parse_unmemoized(parser); });
+    });
+}
+
+auto ExplicitType::parse_unmemoized(Parser& parser) -> Expected<ExplicitType, ParserDiagnostic> {
     // Always check for a modifier and advance past it if present
     const auto modifier_token = parser.peek_token();
     const auto modifier       = TypeModifier::from_token(modifier_token);
@@ -63,13 +71,13 @@ auto ExplicitType::is_equal(const ExplicitType& other) const noexcept -> bool {
 
         // Arrays are recursively defined
         auto inner = TRY(ExplicitType::parse(parser));
-        return ExplicitType{
-            std::move(modifier),
-            ExplicitArrayType{std::move(dimension), make_box<ExplicitType>(std::move(inner))}};
+        return ExplicitType{std::move(modifier),
+                            ExplicitArrayType{std::move(dimension),
+                                              parser.make_box<ExplicitType>(std::move(inner))}};
     } else if (!TypeModifier::from_token(parser.peek_token()).is_value()) {
         // Don't advance since the parser does it implicitly here (costs two from_token calls)
         auto inner = TRY(ExplicitType::parse(parser));
-        return ExplicitType{std::move(modifier), make_box<ExplicitType>(std::move(inner))};
+        return ExplicitType{std::move(modifier), parser.make_box<ExplicitType>(std::move(inner))};
     }
 
     // Otherwise the type has to be a 'simple' function or ident
@@ -136,13 +144,13 @@ auto TypeExpression::parse(Parser& parser)
     auto [type, initialized] =
         TRY(([&]() -> Expected<std::pair<Box<TypeExpression>, bool>, ParserDiagnostic> {
             if (parser.peek_token_is(TokenType::WALRUS)) {
-                auto type = make_box<TypeExpression>(start_token, nullopt);
+                auto type = parser.make_box<TypeExpression>(start_token, nullopt);
                 parser.advance();
                 return std::pair{std::move(type), true};
             } else if (parser.peek_token_is(TokenType::COLON)) {
                 parser.advance();
                 auto explicit_type = TRY(ExplicitType::parse(parser));
-                auto type = make_box<TypeExpression>(start_token, std::move(explicit_type));
+                auto type = parser.make_box<TypeExpression>(start_token, std::move(explicit_type));
                 if (parser.peek_token_is(TokenType::ASSIGN)) {
                     parser.advance();
                     return std::pair{std::move(type), true};
@@ -17,7 +17,7 @@ auto UnionField::is_equal(const UnionField& other) const noexcept -> bool {
     return *ident_ == *other.ident_ && type_ == other.type_;
 }
 
-UnionExpression::UnionExpression(const Token& start_token, std::vector<UnionField> fields) noexcept
+UnionExpression::UnionExpression(const Token& start_token, ArenaVector<UnionField> fields) noexcept
     : ExprBase{start_token}, fields_{std::move(fields)} {}
 UnionExpression::~UnionExpression() = default;
 
@@ -27,7 +27,7 @@ auto UnionExpression::parse(Parser& parser) -> Expected<Box<Expression>, ParserD
     const auto start_token = parser.current_token();
     TRY(parser.expect_peek(TokenType::LBRACE));
 
-    std::vector<UnionField> fields;
+    ArenaVector<UnionField> fields{parser.allocator()};
     while (!parser.peek_token_is(TokenType::RBRACE)) {
         TRY(parser.expect_peek(TokenType::IDENT));
         auto ident = downcast<IdentifierExpression>(TRY(IdentifierExpression::parse(parser)));
@@ -41,7 +41,7 @@ auto UnionExpression::parse(Parser& parser) -> Expected<Box<Expression>, ParserD
     TRY(parser.expect_peek(TokenType::RBRACE));
 
     if (fields.empty()) { return make_parser_unexpected(ParserError::EMPTY_UNION, start_token); }
-    return make_box<UnionExpression>(start_token, std::move(fields));
+    return parser.make_box<UnionExpression>(start_token, std::move(fields));
 }
 
 auto UnionExpression::is_equal(const Node& other) const noexcept -> bool {
@@ -59,11 +59,11 @@ auto WhileLoopExpression::parse(Parser& parser) -> Expected<Box<Expression>, Par
         return make_parser_unexpected(ParserError::EMPTY_WHILE_LOOP, block->get_token());
     }
 
-    return make_box<WhileLoopExpression>(start_token,
-                                         std::move(condition),
-                                         std::move(continuation),
-                                         std::move(block),
-                                         std::move(non_break));
+    return parser.make_box<WhileLoopExpression>(start_token,
+                                                std::move(condition),
+                                                std::move(continuation),
+                                                std::move(block),
+                                                std::move(non_break));
 }
 
 auto WhileLoopExpression::is_equal(const Node& other) const noexcept -> bool {
@@ -0,0 +1,662 @@
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "ast/ast.hpp"
+#include "ast/flat.hpp"
+#include "ast/visitor.hpp"
+
+#include "variant.hpp"
+
+namespace conch::ast {
+
+using flat::NONE;
+
+// Walks a pointer tree without recursing. Each node reserves its slot on the way down and opens a
+// frame with its operands, leaving placeholders for children that are filled in as those children
+// are lowered. Frames are closed in the order a recursive walk would return from them, so nodes
+// and their operands are laid out exactly as one would lay them out.
+class FlatLowering : public Visitor {
+  public:
+    using Index = FlatAST::Index;
+
+  public:
+    FlatLowering(FlatAST& out, std::string_view source, std::span<const Token> tokens)
+        : out_{out}, source_{source} {
+        out_.tokens_ = TokenBuffer{source};
+        out_.tokens_.reserve(tokens.size());
+        for (const auto& token : tokens) {
+            out_.tokens_.push(token.type, offset_of(token), token.slice.size());
+        }
+    }
+
+    // The deferred bodies that failed to load, which are lowered as if there were no body.
+    [[nodiscard]] auto take_failures() noexcept -> std::vector<ParserDiagnostic> {
+        return std::move(failures_);
+    }
+
+    auto lower(const Node& root) -> Index {
+        const auto idx = static_cast<Index>(out_.kinds_.size());
+        pending_.emplace_back(Task{&root, {}});
+        while (!pending_.empty()) {
+            const auto step = pending_.back();
+            pending_.pop_back();
+
+            std::visit(Overloaded{
+                           [&](const Task& task) { lower_one(task); },
+                           [&](const Close& close) { this->close(close.frame); },
+                       },
+                       step);
+
+            // Steps were scheduled in visiting order, so the first one has to end up on top
+            pending_.insert(pending_.end(), scheduled_.rbegin(), scheduled_.rend());
+            scheduled_.clear();
+        }
+        return idx;
+    }
+
+    AST_VISITOR_OVERRIDES()
+
+  private:
+    using Child = std::variant<const Node*, const ExplicitType*>;
+
+    // The placeholder in an open frame that a child's index is written to once it is lowered.
+    struct Target {
+        static constexpr usize NO_FRAME = static_cast<usize>(-1);
+
+        usize frame{NO_FRAME};
+        usize at{0};
+    };
+
+    struct Task {
+        Child  child;
+        Target target;
+    };
+
+    // Writes out the innermost open frame once all of its children have been lowered.
+    struct Close {
+        usize frame;
+    };
+
+    using Step = std::variant<Task, Close>;
+
+    // The operands of one node or record, with placeholders for children that are not lowered yet.
+    class Operands {
+      public:
+        Operands() noexcept = default;
+        Operands(std::initializer_list<Index> words) : words_{words} {}
+        Operands(std::initializer_list<Child> children) {
+            for (const auto& c : children) { child(c); }
+        }
+
+        auto word(Index word) -> void { words_.push_back(word); }
+        auto child(Child child) -> void {
+            children_.push_back({child, words_.size()});
+            words_.push_back(NONE);
+        }
+
+        // Fills a placeholder that was reserved earlier, visiting the child at this point instead.
+        auto child_at(usize at, Child child) -> void { children_.push_back({child, at}); }
+
+        auto optional(const Node* present) -> void {
+            if (present) {
+                child(present);
+            } else {
+                word(NONE);
+            }
+        }
+
+        [[nodiscard]] auto words() const noexcept -> std::span<const Index> { return words_; }
+
+      private:
+        std::vector<Index>                   words_;
+        std::vector<std::pair<Child, usize>> children_;
+
+        friend class FlatLowering;
+    };
+
+    struct Frame {
+        enum class Into : u8 { DATA, EXTRA, RECORD };
+
+        Into     into;
+        Index    idx;
+        Operands operands;
+        Target   target{};
+    };
+
+    // Every visit reserves its own node first, so that is the index its parent points at. Type
+    // records are only appended once closed, so their offset is bound then.
+    auto lower_one(const Task& task) -> void {
+        if (const auto* const* node = std::get_if<const Node*>(&task.child)) {
+            bind(task.target, static_cast<Index>(out_.kinds_.size()));
+            (*node)->accept(*this);
+        } else {
+            lower_type(*std::get<const ExplicitType*>(task.child), task.target);
+        }
+    }
+
+    auto offset_of(const Token& token) const noexcept -> usize {
+        if (token.type == TokenType::END) { return source_.size(); }
+        return static_cast<usize>(token.slice.data() - source_.data());
+    }
+
+    // Finds the stream index of a node's start token, which is NONE for tokens outside the source.
+    // Nodes are reserved close to source order, so the search gallops out from the last token it
+    // found rather than bisecting the whole stream for every node.
+    auto main_token_of(const Token& token) noexcept -> Index {
+        const auto offsets = out_.tokens_.offsets();
+        const auto offset  = static_cast<u32>(offset_of(token));
+        const auto hint    = std::min(hint_, offsets.size());
+
+        // Widen a window on the side of the hint the offset is on until it holds the first token
+        // at or after the offset, then bisect only that window
+        usize lo   = 0;
+        usize hi   = offsets.size();
+        usize step = 1;
+        if (hint < offsets.size() && offsets[hint] < offset) {
+            while (hint + step < offsets.size() && offsets[hint + step] < offset) { step *= 2; }
+            lo = hint + step / 2;
+            hi = std::min(hint + step + 1, offsets.size());
+        } else {
+            while (step <= hint && offsets[hint - step] >= offset) { step *= 2; }
+            lo = step <= hint ? hint - step : 0;
+            hi = std::min(hint - step / 2 + 1, offsets.size());
+        }
+
+        const auto window = offsets.subspan(lo, hi - lo);
+        const auto first  = std::ranges::lower_bound(window, offset) - window.begin();
+        for (auto idx = lo + static_cast<usize>(first);
+             idx < offsets.size() && offsets[idx] == offset;
+             ++idx) {
+            if (out_.tokens_.type(idx) == token.type) {
+                hint_ = idx;
+                return static_cast<Index>(idx);
+            }
+        }
+        return NONE;
+    }
+
+    auto reserve(const Node& node) -> Index { return reserve(node.get_kind(), node.get_token()); }
+
+    auto reserve(NodeKind kind, const Token& token) -> Index {
+        const auto idx = static_cast<Index>(out_.kinds_.size());
+        out_.kinds_.push_back(kind);
+        out_.main_tokens_.push_back(main_token_of(token));
+        out_.data_.push_back({NONE, NONE});
+        return idx;
+    }
+
+    auto bind(const Target& target, Index lowered) noexcept -> void {
+        if (target.frame == Target::NO_FRAME) { return; }
+        frames_[target.frame].operands.words_[target.at] = lowered;
+    }
+
+    // Frames have to be opened in the reverse of the order they are scheduled in, since each one
+    // is closed on top of the frames opened after it.
+    auto open(Frame frame) -> usize {
+        frames_.push_back(std::move(frame));
+        return frames_.size() - 1;
+    }
+
+    // Lowers a frame's children next, closing it right after them.
+    auto schedule(usize frame) -> void {
+        for (const auto& [child, at] : frames_[frame].operands.children_) {
+            scheduled_.emplace_back(Task{child, {frame, at}});
+        }
+        scheduled_.emplace_back(Close{frame});
+    }
+
+    auto close(usize frame) -> void {
+        assert(frame + 1 == frames_.size());
+        const auto  closing = std::move(frames_.back());
+        const auto& words   = closing.operands.words_;
+        frames_.pop_back();
+
+        switch (closing.into) {
+        case Frame::Into::DATA:
+            assert(words.size() <= 2);
+            std::ranges::copy(words, out_.data_[closing.idx].begin());
+            break;
+        case Frame::Into::EXTRA: {
+            const auto start        = append(words);
+            out_.data_[closing.idx] = {start, static_cast<Index>(out_.extra_.size())};
+            break;
+        }
+        case Frame::Into::RECORD: bind(closing.target, append(words)); break;
+        }
+    }
+
+    auto append(std::span<const Index> words) -> Index {
+        const auto start = static_cast<Index>(out_.extra_.size());
+        out_.extra_.insert(out_.extra_.end(), words.begin(), words.end());
+        return start;
+    }
+
+    // Stores up to two operands inline in the node's data.
+    auto finish(Index idx, Operands operands) -> void {
+        schedule(open({Frame::Into::DATA, idx, std::move(operands)}));
+    }
+
+    // Appends a node's operands to the extra data, pointing its data at their range.
+    auto finish_extra(Index idx, Operands operands) -> void {
+        schedule(open({Frame::Into::EXTRA, idx, std::move(operands)}));
+    }
+
+    static auto encode(const TypeModifier& modifier) noexcept -> Index {
+        using Modifier      = TypeModifier::Modifier;
+        const auto one_past = [](Modifier m) -> Index { return std::to_underlying(m) + 1; };
+
+        if (modifier.is_const_ref()) { return one_past(Modifier::REF); }
+        if (modifier.is_mutable_ref()) { return one_past(Modifier::MUT_REF); }
+        if (modifier.is_const_ptr()) { return one_past(Modifier::PTR); }
+        if (modifier.is_mutable_ptr()) { return one_past(Modifier::MUT_PTR); }
+        return 0;
+    }
+
+    auto lower_type(const ExplicitType& type, const Target& target) -> void {
+        using Variant = flat::ExplicitType::Variant;
+
+        Operands record{encode(type.get_modifier())};
+        std::visit(Overloaded{
+                       [&](const ExplicitType::ExplicitIdentType& t) {
+                           record.word(std::to_underlying(Variant::IDENT));
+                           record.child(t.get());
+                           record.word(0);
+                       },
+                       [&](const ExplicitType::ExplicitFunctionType& f) {
+                           record.word(std::to_underlying(Variant::FUNCTION));
+                           record.child(f.get());
+                           record.word(0);
+                       },
+                       [&](const ExplicitArrayType& a) {
+                           record.word(std::to_underlying(Variant::ARRAY));
+                           record.optional(a.has_dimension() ? &a.get_dimension() : nullptr);
+                           record.child(&a.get_inner_type());
+                       },
+                       [&](const ExplicitType::ExplicitRecursiveType& r) {
+                           record.word(std::to_underlying(Variant::RECURSIVE));
+                           record.child(r.get());
+                           record.word(0);
+                       },
+                   },
+                   type.get_type());
+        schedule(open({Frame::Into::RECORD, NONE, std::move(record), target}));
+    }
+
+    template <typename N> auto lower_prefix(const N& node) -> void {
+        finish(reserve(node), {&node.get_rhs()});
+    }
+
+    struct InfixParts {
+        const Expression& lhs;
+        TokenType         op;
+        const Expression& rhs;
+    };
+
+    static auto infix_parts(const Node& node) -> Optional<InfixParts> {
+        const auto parts = [](const auto& infix) {
+            return InfixParts{infix.get_lhs(), infix.get_op(), infix.get_rhs()};
+        };
+
+        switch (node.get_kind()) {
+        case NodeKind::ASSIGNMENT_EXPRESSION: return parts(Node::as<AssignmentExpression>(node));
+        case NodeKind::BINARY_EXPRESSION:     return parts(Node::as<BinaryExpression>(node));
+        case NodeKind::DOT_EXPRESSION:        return parts(Node::as<DotExpression>(node));
+        case NodeKind::RANGE_EXPRESSION:      return parts(Node::as<RangeExpression>(node));
+        case NodeKind::IMPLICIT_DEREFERENCE_EXPRESSION:
+            return parts(Node::as<ImplicitDereferenceExpression>(node));
+        default: return nullopt;
+        }
+    }
+
+    // Left operands of infixes nest as deep as a left associative expression is long, so the whole
+    // left spine is reserved at once and only its innermost operand and the right operands wait.
+    auto lower_infix(const Node& node) -> void {
+        std::vector<InfixParts> spine;
+        std::vector<Index>      slots;
+        for (const Node* it = &node;;) {
+            const auto parts = infix_parts(*it);
+            if (!parts) { break; }
+            slots.push_back(reserve(*it));
+            spine.push_back(*parts);
+            it = &parts->lhs;
+        }
+
+        // The innermost binary is closed first, so it is opened last
+        std::vector<usize> frames(spine.size());
+        for (usize i = 0; i < spine.size(); ++i) {
+            Operands operands;
+            if (i + 1 == spine.size()) {
+                operands.child(&spine[i].lhs);
+            } else {
+                operands.word(slots[i + 1]);
+            }
+            operands.word(std::to_underlying(spine[i].op));
+            operands.child(&spine[i].rhs);
+            frames[i] = open({Frame::Into::EXTRA, slots[i], std::move(operands)});
+        }
+        for (const auto frame : std::views::reverse(frames)) { schedule(frame); }
+    }
+
+    template <typename N> auto lower_primitive(const N& node) -> void {
+        const auto idx = reserve(node);
+        if constexpr (std::same_as<typename N::value_type, std::string_view>) {
+            const auto value  = node.get_value();
+            const auto offset = static_cast<Index>(out_.strings_.size());
+            out_.strings_.append(value);
+            finish(idx, {offset, static_cast<Index>(value.size())});
+        } else {
+            const auto bits = flat::encode_value(node.get_value());
+            finish(idx, {static_cast<Index>(bits), static_cast<Index>(bits >> 32)});
+        }
+    }
+
+    template <typename N> auto lower_wrapper(const N& node, const Node& inner) -> void {
+        finish(reserve(node), {&inner});
+    }
+
+  private:
+    FlatAST&                      out_;
+    std::string_view              source_;
+    std::vector<Step>             pending_;
+    std::vector<Step>             scheduled_;
+    std::vector<Frame>            frames_;
+    std::vector<ParserDiagnostic> failures_;
+    usize                         hint_{0};
+};
+
+auto FlatAST::lower(const AST& ast, std::string_view source, std::span<const Token> tokens)
+    -> std::pair<FlatAST, std::vector<ParserDiagnostic>> {
+    FlatAST      flat;
+    FlatLowering lowering{flat, source, tokens};
+    flat.roots_.reserve(ast.size());
+    for (const auto& node : ast) { flat.roots_.push_back(lowering.lower(*node)); }
+    return {std::move(flat), lowering.take_failures()};
+}
+
+auto FlatLowering::visit(const ArrayExpression& node) -> void {
+    const auto idx = reserve(node);
+    Operands   operands;
+    operands.optional(node.has_explicit_size() ? &node.get_explicit_size() : nullptr);
+    operands.child(&node.get_item_type());
+    for (const auto& item : node.get_items()) { operands.child(item.get()); }
+    finish_extra(idx, std::move(operands));
+}
+
+auto FlatLowering::visit(const CallExpression& node) -> void {
+    const auto idx = reserve(node);
+    Operands   operands;
+    operands.child(&node.get_function());
+    for (const auto& arg : node.get_arguments()) {
+        if (arg.is_expression()) {
+            operands.word(0);
+            operands.child(&arg.get_expression());
+        } else {
+            operands.word(1);
+            operands.child(&arg.get_type());
+        }
+    }
+    finish_extra(idx, std::move(operands));
+}
+
+auto FlatLowering::visit(const DoWhileLoopExpression& node) -> void {
+    finish(reserve(node), {&node.get_block(), &node.get_condition()});
+}
+
+auto FlatLowering::visit(const EnumExpression& node) -> void {
+    const auto idx = reserve(node);
+    Operands   operands;
+    operands.optional(node.has_underlying() ? &node.get_underlying() : nullptr);
+    for (const auto& enumeration : node.get_enumerations()) {
+        operands.child(&enumeration.get_ident());
+        operands.optional(enumeration.has_default_value() ? &enumeration.get_default_value()
+                                                          : nullptr);
+    }
+    finish_extra(idx, std::move(operands));
+}
+
+auto FlatLowering::visit(const ForLoopExpression& node) -> void {
+    const auto idx       = reserve(node);
+    const auto iterables = node.get_iterables();
+
+    // The block and non-break slots are filled in last to keep nodes in source order
+    Operands operands{NONE, NONE, static_cast<Index>(iterables.size())};
+    for (const auto& iterable : iterables) { operands.child(iterable.get()); }
+    for (const auto& capture : node.get_captures()) {
+        if (capture.is_discarded()) {
+            operands.word(0);
+            operands.word(NONE);
+        } else {
+            const auto& valued = capture.get_valued();
+            operands.word(encode(valued.get_modifier()));
+            operands.child(&valued.get_ident());
+        }
+    }
+
+    operands.child_at(0, &node.get_block());
+    if (node.has_non_break()) { operands.child_at(1, &node.get_non_break()); }
+    finish_extra(idx, std::move(operands));
+}
+
+auto FlatLowering::visit(const FunctionExpression& node) -> void {
+    const auto idx = reserve(node);
+    Operands   operands;
+    if (node.has_self()) {
+        const auto& self = node.get_self();
+        operands.word(encode(self.get_modifier()));
+        operands.child(&self.get_ident());
+    } else {
+        operands.word(0);
+        operands.word(NONE);
+    }
+
+    // Parameters come before the return type and body in the source
+    operands.word(NONE);
+    operands.word(NONE);
+    for (const auto& param : node.get_parameters()) {
+        operands.child(&param.get_ident());
+        operands.child(&param.get_type());
+    }
+
+    operands.child_at(2, &node.get_return_type());
+    if (node.has_body()) {
+        if (auto loaded = node.load_body(); loaded) {
+            operands.child_at(3, &node.get_body());
+        } else {
+            failures_.push_back(std::move(loaded.error()));
+        }
+    }
+    finish_extra(idx, std::move(operands));
+}
+
+auto FlatLowering::visit(const IdentifierExpression& node) -> void { finish(reserve(node), {}); }
+
+auto FlatLowering::visit(const IfExpression& node) -> void {
+    const auto idx = reserve(node);
+    Operands   operands;
+    operands.child(&node.get_condition());
+    operands.child(&node.get_consequence());
+    operands.optional(node.has_alternate() ? &node.get_alternate() : nullptr);
+    finish_extra(idx, std::move(operands));
+}
+
+auto FlatLowering::visit(const IndexExpression& node) -> void {
+    finish(reserve(node), {&node.get_array(), &node.get_index()});
+}
+
+auto FlatLowering::visit(const InfiniteLoopExpression& node) -> void {
+    finish(reserve(node), {&node.get_block()});
+}
+
+auto FlatLowering::visit(const AssignmentExpression& node) -> void { lower_infix(node); }
+auto FlatLowering::visit(const BinaryExpression& node) -> void { lower_infix(node); }
+
+// Chains lower to the binaries they stand for, laid out exactly as a left-deep spine would be
+auto FlatLowering::visit(const BinaryChainExpression& node) -> void {
+    const auto         operands = node.get_operands();
+    std::vector<Index> links(operands.size() - 1);
+    for (auto& link : std::views::reverse(links)) {
+        link = reserve(NodeKind::BINARY_EXPRESSION, node.get_token());
+    }
+
+    const auto         op = std::to_underlying(node.get_op());
+    std::vector<usize> frames(links.size());
+    for (usize i = links.size(); i-- > 0;) {
+        Operands binary;
+        if (i == 0) {
+            binary.child(operands[0].get());
+        } else {
+            binary.word(links[i - 1]);
+        }
+        binary.word(op);
+        binary.child(operands[i + 1].get());
+        frames[i] = open({Frame::Into::EXTRA, links[i], std::move(binary)});
+    }
+    for (const auto frame : frames) { schedule(frame); }
+}
+auto FlatLowering::visit(const DotExpression& node) -> void { lower_infix(node); }
+auto FlatLowering::visit(const RangeExpression& node) -> void { lower_infix(node); }
+auto FlatLowering::visit(const ImplicitDereferenceExpression& node) -> void { lower_infix(node); }
+
+auto FlatLowering::visit(const MatchExpression& node) -> void {
+    const auto idx = reserve(node);
+    Operands   operands;
+    operands.child(&node.get_matcher());
+    operands.word(NONE);
+    for (const auto& arm : node.get_arms()) {
+        operands.child(&arm.get_pattern());
+        if (!arm.has_capture_clause()) {
+            operands.word(NONE);
+        } else if (arm.is_discarded_capture()) {
+            operands.word(flat::MatchArm::DISCARDED);
+        } else {
+            operands.child(&arm.get_explicit_capture());
+        }
+        operands.child(&arm.get_dispatch());
+    }
+    if (node.has_catch_all()) { operands.child_at(1, &node.get_catch_all()); }
+    finish_extra(idx, std::move(operands));
+}
+
+auto FlatLowering::visit(const ReferenceExpression& node) -> void { lower_prefix(node); }
+auto FlatLowering::visit(const DereferenceExpression& node) -> void { lower_prefix(node); }
+auto FlatLowering::visit(const ImplicitAccessExpression& node) -> void { lower_prefix(node); }
+auto FlatLowering::visit(const UnaryExpression& node) -> void { lower_prefix(node); }
+
+auto FlatLowering::visit(const StringExpression& node) -> void { lower_primitive(node); }
+auto FlatLowering::visit(const SignedIntegerExpression& node) -> void { lower_primitive(node); }
+auto FlatLowering::visit(const SignedLongIntegerExpression& node) -> void {
+    lower_primitive(node);
+}
+auto FlatLowering::visit(const ISizeIntegerExpression& node) -> void { lower_primitive(node); }
+auto FlatLowering::visit(const UnsignedIntegerExpression& node) -> void { lower_primitive(node); }
+auto FlatLowering::visit(const UnsignedLongIntegerExpression& node) -> void {
+    lower_primitive(node);
+}
+auto FlatLowering::visit(const USizeIntegerExpression& node) -> void { lower_primitive(node); }
+auto FlatLowering::visit(const ByteExpression& node) -> void { lower_primitive(node); }
+auto FlatLowering::visit(const FloatExpression& node) -> void { lower_primitive(node); }
+auto FlatLowering::visit(const DoubleExpression& node) -> void { lower_primitive(node); }
+auto FlatLowering::visit(const BoolExpression& node) -> void { lower_primitive(node); }
+
+auto FlatLowering::visit(const ScopeResolutionExpression& node) -> void {
+    finish(reserve(node), {&node.get_outer(), &node.get_inner()});
+}
+
+auto FlatLowering::visit(const StructExpression& node) -> void {
+    const auto idx = reserve(node);
+    Operands   operands;
+    for (const auto& member : node.get_members()) { operands.child(member.get()); }
+    finish_extra(idx, std::move(operands));
+}
+
+auto FlatLowering::visit(const TypeExpression& node) -> void {
+    const auto idx = reserve(node);
+    Operands   operands;
+    if (node.has_explicit_type()) {
+        operands.child(&node.get_explicit_type());
+    } else {
+        operands.word(NONE);
+    }
+    finish(idx, std::move(operands));
+}
+
+auto FlatLowering::visit(const UnionExpression& node) -> void {
+    const auto idx = reserve(node);
+    Operands   operands;
+    for (const auto& field : node.get_fields()) {
+        operands.child(&field.get_ident());
+        operands.child(&field.get_type());
+    }
+    finish_extra(idx, std::move(operands));
+}
+
+auto FlatLowering::visit(const WhileLoopExpression& node) -> void {
+    const auto idx = reserve(node);
+    Operands   operands;
+    operands.child(&node.get_condition());
+    operands.optional(node.has_continuation() ? &node.get_continuation() : nullptr);
+    operands.child(&node.get_block());
+    operands.optional(node.has_non_break() ? &node.get_non_break() : nullptr);
+    finish_extra(idx, std::move(operands));
+}
+
+auto FlatLowering::visit(const BlockStatement& node) -> void {
+    const auto idx = reserve(node);
+    Operands   operands;
+    for (const auto& stmt : node) { operands.child(stmt.get()); }
+    finish_extra(idx, std::move(operands));
+}
+
+auto FlatLowering::visit(const DeclStatement& node) -> void {
+    const auto idx = reserve(node);
+    Operands   operands;
+    operands.child(&node.get_ident());
+    operands.child(&node.get_type());
+    operands.optional(node.has_value() ? &node.get_value() : nullptr);
+    operands.word(static_cast<Index>(std::to_underlying(node.get_modifiers())));
+    finish_extra(idx, std::move(operands));
+}
+
+auto FlatLowering::visit(const DeferStatement& node) -> void {
+    lower_wrapper(node, node.get_deferred());
+}
+
+auto FlatLowering::visit(const DiscardStatement& node) -> void {
+    lower_wrapper(node, node.get_discarded());
+}
+
+auto FlatLowering::visit(const ExpressionStatement& node) -> void {
+    lower_wrapper(node, node.get_expression());
+}
+
+auto FlatLowering::visit(const ImportStatement& node) -> void {
+    const auto idx = reserve(node);
+    Operands   operands;
+    if (node.is_module_import()) {
+        operands.child(&node.get_module_import());
+    } else {
+        operands.child(&node.get_user_import());
+    }
+    operands.optional(node.has_alias() ? &node.get_alias() : nullptr);
+    finish(idx, std::move(operands));
+}
+
+auto FlatLowering::visit(const JumpStatement& node) -> void {
+    const auto idx = reserve(node);
+    Operands   operands;
+    operands.optional(node.has_expression() ? &node.get_expression() : nullptr);
+    operands.word(NONE);
+    finish(idx, std::move(operands));
+}
+
+auto FlatLowering::visit(const UsingStatement& node) -> void {
+    finish(reserve(node), {&node.get_alias(), &node.get_type()});
+}
+
+} // namespace conch::ast
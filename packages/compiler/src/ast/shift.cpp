@@ -0,0 +1,325 @@
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "ast/ast.hpp"
+#include "ast/shift.hpp"
+#include "ast/visitor.hpp"
+
+#include "variant.hpp"
+
+namespace conch::ast {
+
+auto TokenShift::between(std::string_view from,
+                         const Token&     before,
+                         std::string_view to,
+                         const Token&     after) noexcept -> TokenShift {
+    const auto old_offset = static_cast<isize>(before.slice.data() - from.data());
+    const auto new_offset = static_cast<isize>(after.slice.data() - to.data());
+    return {
+        .from    = from,
+        .to      = to,
+        .behind  = static_cast<usize>(old_offset),
+        .offset  = new_offset - old_offset,
+        .lines   = static_cast<isize>(after.line) - static_cast<isize>(before.line),
+        .line    = before.line,
+        .columns = static_cast<isize>(after.column) - static_cast<isize>(before.column),
+    };
+}
+
+auto TokenShift::apply(const Token& token) const noexcept -> Token {
+    assert(token.slice.data() >= from.data() &&
+           token.slice.data() + token.slice.size() <= from.data() + from.size());
+    const auto old_offset = static_cast<usize>(token.slice.data() - from.data());
+    if (old_offset < behind) {
+        return {token.type, to.substr(old_offset, token.slice.size()), token.line, token.column};
+    }
+
+    const auto moved = static_cast<isize>(old_offset) + offset;
+    const auto line  = static_cast<usize>(static_cast<isize>(token.line) + lines);
+    const auto column =
+        token.line == this->line ? static_cast<usize>(static_cast<isize>(token.column) + columns)
+                                 : token.column;
+    return {token.type, to.substr(static_cast<usize>(moved), token.slice.size()), line, column};
+}
+
+auto TokenShift::apply(usize token_index) const noexcept -> usize {
+    if (token_index < behind_index) { return token_index; }
+    return static_cast<usize>(static_cast<isize>(token_index) + tokens);
+}
+
+// Shifts nodes off a worklist instead of recursing, since operator chains nest without limit.
+// Without a shift it only walks the nodes, looking for the block that opens at a brace.
+class TokenShifter : public Visitor {
+  public:
+    explicit TokenShifter(const TokenShift& shift) noexcept : shift_{&shift} {}
+    explicit TokenShifter(const Token& brace) noexcept : brace_{brace.slice.data()} {}
+
+    auto run(const Node& root) -> void {
+        pending_.push_back(&root);
+        while (!pending_.empty() && !found_.block && !found_.deferred) {
+            const auto* node = pending_.back();
+            pending_.pop_back();
+
+            // Nodes are only ever created mutable in their arenas, their tokens are const to users
+            if (shift_) {
+                auto& token = const_cast<Node&>(*node).start_token_;
+                token       = shift_->apply(token);
+            }
+            node->accept(*this);
+        }
+    }
+
+    [[nodiscard]] auto found() const noexcept -> const EnclosingBlock& { return found_; }
+
+    // The old statements are moved out before shifting, so only the rest of the node is walked
+    static auto splice(const Node&           node,
+                       const TokenShift&     shift,
+                       const BlockStatement& block,
+                       BlockStatement&&      replacement) -> void {
+        auto&                       target = const_cast<BlockStatement&>(block);
+        ArenaVector<Box<Statement>> dropped{std::move(target.statements_)};
+        TokenShifter{shift}.run(node);
+        target.statements_ = std::move(replacement.statements_);
+    }
+
+    AST_VISITOR_OVERRIDES()
+
+  private:
+    auto push(const Node& node) -> void { pending_.push_back(&node); }
+
+    auto push(const ExplicitType& type) -> void {
+        for (const auto* it = &type; it;) {
+            const auto* current = it;
+            it                  = nullptr;
+            std::visit(Overloaded{
+                           [&](const ExplicitType::ExplicitIdentType& t) { push(*t); },
+                           [&](const ExplicitType::ExplicitFunctionType& f) { push(*f); },
+                           [&](const ExplicitArrayType& a) {
+                               if (a.has_dimension()) { push(a.get_dimension()); }
+                               it = &a.get_inner_type();
+                           },
+                           [&](const ExplicitType::ExplicitRecursiveType& r) { it = &*r; },
+                       },
+                       current->get_type());
+        }
+    }
+
+    template <typename N> auto push_infix(const N& node) -> void {
+        push(node.get_lhs());
+        push(node.get_rhs());
+    }
+
+  private:
+    const TokenShift*        shift_{nullptr};
+    const char*              brace_{nullptr};
+    EnclosingBlock           found_{};
+    std::vector<const Node*> pending_;
+};
+
+auto shift_tokens(const Node& node, const TokenShift& shift) -> void {
+    TokenShifter{shift}.run(node);
+}
+
+auto shift_tokens(const Node&           node,
+                  const TokenShift&     shift,
+                  const BlockStatement& block,
+                  BlockStatement&&      replacement) -> void {
+    TokenShifter::splice(node, shift, block, std::move(replacement));
+}
+
+auto find_block(const Node& node, const Token& brace) -> EnclosingBlock {
+    TokenShifter finder{brace};
+    finder.run(node);
+    return finder.found();
+}
+
+auto TokenShifter::visit(const ArrayExpression& node) -> void {
+    if (node.has_explicit_size()) { push(node.get_explicit_size()); }
+    push(node.get_item_type());
+    for (const auto& item : node.get_items()) { push(*item); }
+}
+
+auto TokenShifter::visit(const CallExpression& node) -> void {
+    push(node.get_function());
+    for (const auto& arg : node.get_arguments()) {
+        if (arg.is_expression()) {
+            push(arg.get_expression());
+        } else {
+            push(arg.get_type());
+        }
+    }
+}
+
+auto TokenShifter::visit(const DoWhileLoopExpression& node) -> void {
+    push(node.get_block());
+    push(node.get_condition());
+}
+
+auto TokenShifter::visit(const EnumExpression& node) -> void {
+    if (node.has_underlying()) { push(node.get_underlying()); }
+    for (const auto& enumeration : node.get_enumerations()) {
+        push(enumeration.get_ident());
+        if (enumeration.has_default_value()) { push(enumeration.get_default_value()); }
+    }
+}
+
+auto TokenShifter::visit(const ForLoopExpression& node) -> void {
+    for (const auto& iterable : node.get_iterables()) { push(*iterable); }
+    for (const auto& capture : node.get_captures()) {
+        if (!capture.is_discarded()) { push(capture.get_valued().get_ident()); }
+    }
+    push(node.get_block());
+    if (node.has_non_break()) { push(node.get_non_break()); }
+}
+
+auto TokenShifter::visit(const FunctionExpression& node) -> void {
+    if (node.has_self()) { push(node.get_self().get_ident()); }
+    for (const auto& param : node.get_parameters()) {
+        push(param.get_ident());
+        push(param.get_type());
+    }
+    push(node.get_return_type());
+    if (!node.has_body()) { return; }
+
+    // Bodies are only found by their braces, never read, when looking for a block
+    auto& range = node.body_range_;
+    if (!shift_) {
+        if (range.source && range.tokens().front().slice.data() == brace_) {
+            found_.deferred = &node;
+        } else if (!range.source) {
+            push(node.get_body());
+        }
+        return;
+    }
+
+    // Reused tokens are identical in the edited source, so unread bodies are read from there. An
+    // edit inside of a body keeps its opening brace in place and moves its closing one.
+    if (range.source && shift_->deferred) {
+        range.source = shift_->deferred;
+        range.begin  = shift_->apply(range.begin);
+        range.end    = shift_->apply(range.end);
+        return;
+    }
+
+    // A body that fails to load stays deferred in the previous source, which reports it again
+    if (node.load_body()) { push(node.get_body()); }
+}
+
+auto TokenShifter::visit(const IdentifierExpression&) -> void {}
+
+auto TokenShifter::visit(const IfExpression& node) -> void {
+    push(node.get_condition());
+    push(node.get_consequence());
+    if (node.has_alternate()) { push(node.get_alternate()); }
+}
+
+auto TokenShifter::visit(const IndexExpression& node) -> void {
+    push(node.get_array());
+    push(node.get_index());
+}
+
+auto TokenShifter::visit(const InfiniteLoopExpression& node) -> void { push(node.get_block()); }
+
+auto TokenShifter::visit(const AssignmentExpression& node) -> void { push_infix(node); }
+auto TokenShifter::visit(const BinaryExpression& node) -> void { push_infix(node); }
+auto TokenShifter::visit(const BinaryChainExpression& node) -> void {
+    for (const auto& operand : node.get_operands()) { push(*operand); }
+}
+auto TokenShifter::visit(const DotExpression& node) -> void { push_infix(node); }
+auto TokenShifter::visit(const RangeExpression& node) -> void { push_infix(node); }
+auto TokenShifter::visit(const ImplicitDereferenceExpression& node) -> void { push_infix(node); }
+
+auto TokenShifter::visit(const MatchExpression& node) -> void {
+    push(node.get_matcher());
+    for (const auto& arm : node.get_arms()) {
+        push(arm.get_pattern());
+        if (arm.has_capture_clause() && !arm.is_discarded_capture()) {
+            push(arm.get_explicit_capture());
+        }
+        push(arm.get_dispatch());
+    }
+    if (node.has_catch_all()) { push(node.get_catch_all()); }
+}
+
+auto TokenShifter::visit(const ReferenceExpression& node) -> void { push(node.get_rhs()); }
+auto TokenShifter::visit(const DereferenceExpression& node) -> void { push(node.get_rhs()); }
+auto TokenShifter::visit(const ImplicitAccessExpression& node) -> void { push(node.get_rhs()); }
+auto TokenShifter::visit(const UnaryExpression& node) -> void { push(node.get_rhs()); }
+
+auto TokenShifter::visit(const StringExpression&) -> void {}
+auto TokenShifter::visit(const SignedIntegerExpression&) -> void {}
+auto TokenShifter::visit(const SignedLongIntegerExpression&) -> void {}
+auto TokenShifter::visit(const ISizeIntegerExpression&) -> void {}
+auto TokenShifter::visit(const UnsignedIntegerExpression&) -> void {}
+auto TokenShifter::visit(const UnsignedLongIntegerExpression&) -> void {}
+auto TokenShifter::visit(const USizeIntegerExpression&) -> void {}
+auto TokenShifter::visit(const ByteExpression&) -> void {}
+auto TokenShifter::visit(const FloatExpression&) -> void {}
+auto TokenShifter::visit(const DoubleExpression&) -> void {}
+auto TokenShifter::visit(const BoolExpression&) -> void {}
+
+auto TokenShifter::visit(const ScopeResolutionExpression& node) -> void {
+    push(node.get_outer());
+    push(node.get_inner());
+}
+
+auto TokenShifter::visit(const StructExpression& node) -> void {
+    for (const auto& member : node.get_members()) { push(*member); }
+}
+
+auto TokenShifter::visit(const TypeExpression& node) -> void {
+    if (node.has_explicit_type()) { push(node.get_explicit_type()); }
+}
+
+auto TokenShifter::visit(const UnionExpression& node) -> void {
+    for (const auto& field : node.get_fields()) {
+        push(field.get_ident());
+        push(field.get_type());
+    }
+}
+
+auto TokenShifter::visit(const WhileLoopExpression& node) -> void {
+    push(node.get_condition());
+    if (node.has_continuation()) { push(node.get_continuation()); }
+    push(node.get_block());
+    if (node.has_non_break()) { push(node.get_non_break()); }
+}
+
+auto TokenShifter::visit(const BlockStatement& node) -> void {
+    if (!shift_ && node.get_token().slice.data() == brace_) {
+        found_.block = &node;
+        return;
+    }
+    for (const auto& stmt : node) { push(*stmt); }
+}
+
+auto TokenShifter::visit(const DeclStatement& node) -> void {
+    push(node.get_ident());
+    push(node.get_type());
+    if (node.has_value()) { push(node.get_value()); }
+}
+
+auto TokenShifter::visit(const DeferStatement& node) -> void { push(node.get_deferred()); }
+auto TokenShifter::visit(const DiscardStatement& node) -> void { push(node.get_discarded()); }
+auto TokenShifter::visit(const ExpressionStatement& node) -> void { push(node.get_expression()); }
+
+auto TokenShifter::visit(const ImportStatement& node) -> void {
+    if (node.is_module_import()) {
+        push(node.get_module_import());
+    } else {
+        push(node.get_user_import());
+    }
+    if (node.has_alias()) { push(node.get_alias()); }
+}
+
+auto TokenShifter::visit(const JumpStatement& node) -> void {
+    if (node.has_expression()) { push(node.get_expression()); }
+}
+
+auto TokenShifter::visit(const UsingStatement& node) -> void {
+    push(node.get_alias());
+    push(node.get_type());
+}
+
+} // namespace conch::ast
@@ -9,8 +9,9 @@ auto BlockStatement::accept(Visitor& v) const -> void { v.visit(*this); }
 
 auto BlockStatement::parse(Parser& parser) -> Expected<Box<Statement>, ParserDiagnostic> {
     const auto start_token = parser.current_token();
+    const auto depth       = parser.depth();
 
-    std::vector<Box<Statement>> statements;
+    ArenaVector<Box<Statement>> statements{parser.allocator()};
     while (!parser.peek_token_is(TokenType::RBRACE) && !parser.peek_token_is(TokenType::END)) {
         parser.advance();
         auto inner_stmt = TRY(parser.parse_statement());
@@ -24,7 +25,7 @@ auto BlockStatement::parse(Parser& parser) -> Expected<Box<Statement>, ParserDia
     }
     TRY(parser.expect_peek(TokenType::RBRACE));
 
-    return make_box<BlockStatement>(start_token, std::move(statements));
+    return parser.make_box<BlockStatement>(start_token, std::move(statements), depth);
 }
 
 } // namespace conch::ast
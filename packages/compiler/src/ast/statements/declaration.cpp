@@ -57,11 +57,11 @@ auto DeclStatement::parse(Parser& parser) -> Expected<Box<Statement>, ParserDiag
     if (!parser.current_token_is(TokenType::SEMICOLON)) {
         TRY(parser.expect_peek(TokenType::SEMICOLON));
     }
-    return make_box<DeclStatement>(start_token,
-                                   std::move(decl_name),
-                                   std::move(decl_type_expr),
-                                   std::move(decl_value),
-                                   modifiers);
+    return parser.make_box<DeclStatement>(start_token,
+                                          std::move(decl_name),
+                                          std::move(decl_type_expr),
+                                          std::move(decl_value),
+                                          modifiers);
 }
 
 auto DeclStatement::is_equal(const Node& other) const noexcept -> bool {
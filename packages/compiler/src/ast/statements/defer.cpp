@@ -21,7 +21,7 @@ auto DeferStatement::parse(Parser& parser) -> Expected<Box<Statement>, ParserDia
     if (!stmt->any<ExpressionStatement, DiscardStatement, BlockStatement>()) {
         return make_parser_unexpected(ParserError::ILLEGAL_DEFERRED_STATEMENT, stmt->get_token());
     }
-    return make_box<DeferStatement>(start_token, std::move(stmt));
+    return parser.make_box<DeferStatement>(start_token, std::move(stmt));
 }
 
 } // namespace conch::ast
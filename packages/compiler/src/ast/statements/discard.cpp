@@ -21,7 +21,7 @@ auto DiscardStatement::parse(Parser& parser) -> Expected<Box<Statement>, ParserD
     if (!parser.current_token_is(TokenType::SEMICOLON)) {
         TRY(parser.expect_peek(TokenType::SEMICOLON));
     }
-    return make_box<DiscardStatement>(start_token, std::move(expr));
+    return parser.make_box<DiscardStatement>(start_token, std::move(expr));
 }
 
 } // namespace conch::ast
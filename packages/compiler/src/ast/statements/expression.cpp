@@ -13,7 +13,7 @@ auto ExpressionStatement::parse(Parser& parser) -> Expected<Box<Statement>, Pars
     if (!parser.current_token_is(TokenType::SEMICOLON)) {
         TRY(parser.expect_peek(TokenType::SEMICOLON));
     }
-    return make_box<ExpressionStatement>(start_token, std::move(expr));
+    return parser.make_box<ExpressionStatement>(start_token, std::move(expr));
 }
 
 } // namespace conch::ast
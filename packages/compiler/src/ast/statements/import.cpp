@@ -46,7 +46,8 @@ auto ImportStatement::parse(Parser& parser) -> Expected<Box<Statement>, ParserDi
     if (!parser.current_token_is(TokenType::SEMICOLON)) {
         TRY(parser.expect_peek(TokenType::SEMICOLON));
     }
-    return make_box<ImportStatement>(start_token, std::move(imported), std::move(imported_alias));
+    return parser.make_box<ImportStatement>(
+        start_token, std::move(imported), std::move(imported_alias));
 }
 
 auto ImportStatement::is_equal(const Node& other) const noexcept -> bool {
@@ -17,7 +17,7 @@ auto JumpStatement::parse(Parser& parser) -> Expected<Box<Statement>, ParserDiag
     }
 
     TRY(parser.expect_peek(TokenType::SEMICOLON));
-    return make_box<JumpStatement>(start_token, std::move(value));
+    return parser.make_box<JumpStatement>(start_token, std::move(value));
 }
 
 } // namespace conch::ast
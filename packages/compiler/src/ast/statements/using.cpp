@@ -25,7 +25,7 @@ auto UsingStatement::parse(Parser& parser) -> Expected<Box<Statement>, ParserDia
     auto type = TRY(ExplicitType::parse(parser));
 
     TRY(parser.expect_peek(TokenType::SEMICOLON));
-    return make_box<UsingStatement>(start_token, std::move(alias), std::move(type));
+    return parser.make_box<UsingStatement>(start_token, std::move(alias), std::move(type));
 }
 
 auto UsingStatement::is_equal(const Node& other) const noexcept -> bool {
@@ -0,0 +1,31 @@
+#include <algorithm>
+
+#include "lexer/integer_table.hpp"
+
+namespace conch {
+
+auto IntegerTable::record(usize offset, u64 value, bool overflow) -> void {
+    if (!literals_.empty() && literals_.back().offset >= offset) {
+        const auto stale = std::ranges::lower_bound(literals_, offset, {}, &IntegerLiteral::offset);
+        literals_.erase(stale, literals_.end());
+    }
+    literals_.push_back({static_cast<u32>(offset), overflow, value});
+}
+
+auto IntegerTable::append(const IntegerTable& other, usize from) -> void {
+    const auto first = std::ranges::lower_bound(other.literals_, from, {}, &IntegerLiteral::offset);
+    for (const auto& literal : std::ranges::subrange{first, other.literals_.end()}) {
+        record(literal.offset, literal.value, literal.overflow);
+    }
+}
+
+auto IntegerTable::find(usize offset) const noexcept -> Optional<IntegerLiteral> {
+    // Parsers almost always ask about the literal they just lexed
+    if (!literals_.empty() && literals_.back().offset == offset) { return literals_.back(); }
+
+    const auto it = std::ranges::lower_bound(literals_, offset, {}, &IntegerLiteral::offset);
+    if (it == literals_.end() || it->offset != offset) { return nullopt; }
+    return *it;
+}
+
+} // namespace conch
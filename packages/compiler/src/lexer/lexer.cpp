@@ -1,92 +1,306 @@
+#include <algorithm>
 #include <cassert>
-#include <cctype>
+#include <limits>
 #include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include "lexer/char_class.hpp"
 #include "lexer/keywords.hpp"
 #include "lexer/lexer.hpp"
 #include "lexer/operators.hpp"
 #include "lexer/token.hpp"
 
-namespace conch {
+#include "parallel.hpp"
+#include "simd.hpp"
+#include "source_limits.hpp"
+#include "swar.hpp"
+#include "unicode.hpp"
 
-Lexer::Snapshot::Snapshot(const Lexer& l) noexcept
-    : pos_{l.pos_}, peek_pos_{l.peek_pos_}, current_byte_{l.current_byte_}, line_no_{l.line_no_},
-      col_no_{l.col_no_} {}
+namespace conch {
 
-auto Lexer::reset(std::string_view input) noexcept -> void { *this = Lexer{input}; }
+template <LexerPolicy Policy>
+auto BasicLexer<Policy>::reset(std::string_view input) noexcept -> void {
+    *this = BasicLexer{input};
+}
 
-auto Lexer::advance() noexcept -> Token {
+template <LexerPolicy Policy> auto BasicLexer<Policy>::advance() noexcept -> Token {
+    [[maybe_unused]] const auto trivia_start = std::min(pos_, input_.size());
     skip_whitespace();
+    if constexpr (Policy.retain_trivia) {
+        trivia_.push(trivia_start, std::min(pos_, input_.size()));
+    }
 
-    const auto start_line = line_no_;
-    const auto start_col  = col_no_;
-
-    Token      token{{}, {}, start_line, start_col};
-    const auto maybe_operator = read_operator();
+    const auto& info = char_info(current_byte_);
+    Token       token{TokenType::ILLEGAL, {}, line_no_, col_no_};
 
-    if (maybe_operator) {
-        if (maybe_operator->type == TokenType::END) { return *maybe_operator; }
-        for (size_t i = 0; i < maybe_operator->slice.size(); ++i) { read_character(); }
+    if (info.is(CharClass::OPERATOR_START)) {
+        const auto maybe_operator = read_operator();
+        if (maybe_operator) {
+            for (size_t i = 0; i < maybe_operator->slice.size(); ++i) { read_character(); }
 
-        if (maybe_operator->type == TokenType::COMMENT) { return read_comment(); }
-        if (maybe_operator->type == TokenType::MULTILINE_STRING) { return read_multiline_string(); }
+            if (maybe_operator->type == TokenType::COMMENT) { return read_comment(); }
+            if (maybe_operator->type == TokenType::MULTILINE_STRING) {
+                return read_multiline_string();
+            }
 
-        return *maybe_operator;
+            return *maybe_operator;
+        }
     }
 
-    const auto maybe_misc_token_type = token_type::misc_from_char(current_byte_);
-    if (maybe_misc_token_type) {
+    switch (info.action) {
+    case LexAction::END: return {TokenType::END, {}, line_no_, col_no_};
+    case LexAction::MISC:
         token.slice = input_.substr(pos_, 1);
-        token.type  = *maybe_misc_token_type;
-    } else if (current_byte_ == '@') {
-        token.slice = read_ident(true);
+        token.type  = info.misc;
+        break;
+    case LexAction::BUILTIN:
+        token.slice = read_ident();
         token.type  = lu_builtin(token.slice);
         return token;
-    } else if (std::isalpha(current_byte_)) {
-        token.slice = read_ident(false);
+    case LexAction::IDENT:
+        token.slice = read_ident();
         token.type  = lu_ident(token.slice);
         return token;
-    } else if (std::isdigit(current_byte_)) {
-        return read_number();
-    } else if (current_byte_ == '"') {
-        return read_string();
-    } else if (current_byte_ == '\'') {
-        return read_byte_literal();
-    } else {
+    case LexAction::NUMBER: return read_number();
+    case LexAction::STRING: return read_string();
+    case LexAction::BYTE:   return read_byte_literal();
+    case LexAction::UNICODE: {
+        if (unicode_ident_length(unicode::is_xid_start) != 0) {
+            token.slice = read_ident();
+            token.type  = lu_ident(token.slice);
+            return token;
+        }
+
+        // Anything else is illegal as a whole code point, or as a single byte if malformed
+        const auto cp     = unicode::decode(input_, pos_);
+        const auto length = cp ? cp->length : u8{1};
+        token.slice       = input_.substr(pos_, length);
+        read_character(length);
+        return token;
+    }
+    case LexAction::ILLEGAL:
         token.slice = input_.substr(pos_, 1);
         token.type  = TokenType::ILLEGAL;
+        break;
     }
 
     read_character();
     return token;
 }
 
-auto Lexer::consume() -> std::vector<Token> {
+template <LexerPolicy Policy> auto BasicLexer<Policy>::consume() -> TokenBuffer {
+    if constexpr (Policy.track_positions) {
+        return lex_untracked([](auto& lexer) { return lexer.consume(); });
+    }
+    reset(input_);
+
+    // Tokens average a few bytes of source each, so this rarely needs to grow
+    TokenBuffer tokens{input_};
+    tokens.reserve(input_.size() / 4 + 1);
+    do { tokens.push(compact(advance())); } while (tokens.types().back() != TokenType::END);
+
+    return tokens;
+}
+
+template <LexerPolicy Policy>
+auto BasicLexer<Policy>::consume_parallel(const ParallelLexOptions& options) -> TokenBuffer {
+    if constexpr (Policy.retain_trivia) { return consume(); }
+    if constexpr (Policy.track_positions) {
+        return lex_untracked([&](auto& lexer) { return lexer.consume_parallel(options); });
+    }
+
+    const auto threads = options.threads == 0
+                             ? std::max(usize{1}, usize{std::thread::hardware_concurrency()})
+                             : options.threads;
+    const auto chunk_count =
+        std::min(threads, input_.size() / std::max(usize{1}, options.min_chunk_size));
+    if (chunk_count <= 1) { return consume(); }
+
+    // Every chunk but the first starts just after a newline, dropping any that collapse together
+    std::vector<usize> bounds{0};
+    for (usize i = 1; i < chunk_count; ++i) {
+        const auto target = std::max(i * input_.size() / chunk_count, bounds.back());
+        const auto bound  = simd::find(input_, target, '\n') + 1;
+        if (bound < input_.size() && bound > bounds.back()) { bounds.push_back(bound); }
+    }
+    bounds.push_back(input_.size() + 1);
+
+    struct Chunk {
+        TokenBuffer  tokens;
+        IntegerTable integers;
+        usize        exit{0};
+    };
+
+    const auto         chunks = bounds.size() - 1;
+    std::vector<Chunk> speculated(chunks, Chunk{TokenBuffer{input_}, {}, 0});
+    const auto         lex = [&](usize i) {
+        BasicLexer worker{input_};
+        speculated[i].tokens.reserve((bounds[i + 1] - bounds[i]) / 4 + 1);
+        speculated[i].exit     = worker.lex_chunk(bounds[i], bounds[i + 1], speculated[i].tokens);
+        speculated[i].integers = std::move(worker.integers_);
+    };
+
+    parallel::fork_join(chunks, lex);
+
+    // The first chunk is always right, after which the stream must land on a speculated token
+    TokenBuffer tokens{input_};
+    tokens.reserve(input_.size() / 4 + 1);
+    tokens.append(speculated[0].tokens);
+    IntegerTable integers;
+    integers.append(speculated[0].integers, 0);
+    auto next = speculated[0].exit;
+
+    for (usize i = 1; i < chunks && tokens.types().back() != TokenType::END; ++i) {
+        if (next >= bounds[i + 1]) { continue; }
+
+        const auto& chunk   = speculated[i];
+        const auto  offsets = chunk.tokens.offsets();
+        const auto  synced  = std::ranges::lower_bound(offsets, next);
+        if (synced != offsets.end() && *synced == next) {
+            tokens.append(chunk.tokens, static_cast<usize>(synced - offsets.begin()));
+            integers.append(chunk.integers, next);
+            next = chunk.exit;
+        } else {
+            BasicLexer relexer{input_};
+            const auto from = next;
+            next            = relexer.lex_chunk(from, bounds[i + 1], tokens);
+            integers.append(relexer.integers_, from);
+        }
+    }
+
+    // Leave the lexer exhausted, just as a serial consume would
+    reset(input_);
+    jump_to(tokens.offsets().back());
+    integers_ = std::move(integers);
+    return tokens;
+}
+
+// The lexer decides where a token ends by looking at most this many bytes past it, which happens
+// when checking for a multiline string continuation after a CRLF.
+constexpr usize RELEX_LOOKAHEAD = 4;
+
+template <LexerPolicy Policy>
+auto BasicLexer<Policy>::relex(const TokenBuffer& previous, const TextEdit& edit)
+    -> TokenBuffer {
+    if constexpr (Policy.retain_trivia) { return consume(); }
+    if constexpr (Policy.track_positions) {
+        return lex_untracked([&](auto& lexer) { return lexer.relex(previous, edit); });
+    }
+
+    reset(input_);
+
+    // Reuse every token whose lookahead window stays clear of the edit
+    const auto offsets = previous.offsets();
+    const auto lengths = previous.lengths();
+    usize      reused  = 0;
+    while (reused < previous.size() && previous.type(reused) != TokenType::END &&
+           offsets[reused] + lengths[reused] + RELEX_LOOKAHEAD <= edit.offset) {
+        reused += 1;
+    }
+
+    TokenBuffer tokens{input_};
+    tokens.reserve(previous.size() + edit.replacement.size() / 4 + 1);
+    for (usize i = 0; i < reused; ++i) { tokens.push(previous.compact(i)); }
+    if (reused > 0) { jump_to(offsets[reused - 1] + lengths[reused - 1]); }
+
+    // Relex until a token past the edit starts exactly where a shifted old token did. Comments and
+    // multiline strings are skipped since their slices begin after the token's opening operator.
+    const auto edit_end = edit.offset + edit.replacement.size();
+    const auto delta    = edit.delta();
+    auto       old_idx  = reused;
+    while (true) {
+        const auto token = compact(advance());
+        if (token.offset >= edit_end && token.type != TokenType::COMMENT &&
+            token.type != TokenType::MULTILINE_STRING) {
+            const auto old_offset = static_cast<usize>(static_cast<isize>(token.offset) - delta);
+            while (old_idx < previous.size() && offsets[old_idx] < old_offset) { old_idx += 1; }
+            if (old_idx < previous.size() && offsets[old_idx] == old_offset &&
+                previous.type(old_idx) == token.type) {
+                tokens.append(previous, old_idx, delta);
+                break;
+            }
+        }
+
+        tokens.push(token);
+        if (token.type == TokenType::END) { break; }
+    }
+
     reset(input_);
+    jump_to(tokens.offsets().back());
+    return tokens;
+}
 
-    std::vector<Token> tokens;
-    do { tokens.emplace_back(advance()); } while (tokens.back().type != TokenType::END);
+// Pushes the tokens starting in [from, until) onto the buffer. Returns the offset of the first token
+// starting at or after `until`, or stops after pushing the end token. Only bulk lexing calls this,
+// which never tracks positions.
+template <LexerPolicy Policy>
+auto BasicLexer<Policy>::lex_chunk(usize from, usize until, TokenBuffer& tokens) -> usize {
+    jump_to(from);
 
+    while (true) {
+        const auto token = compact(advance());
+        if (token.offset >= until) { return token.offset; }
+
+        tokens.push(token);
+        if (token.type == TokenType::END) { return token.offset; }
+    }
+}
+
+// Lexes in bulk with the sibling lexer that compiles out position tracking, then takes over its
+// decoded state and counts the lines it skipped in one pass.
+template <LexerPolicy Policy>
+template <typename F>
+auto BasicLexer<Policy>::lex_untracked(F&& lex) -> TokenBuffer {
+    BasicLexer<Policy.without_positions()> lexer{input_};
+    auto                                   tokens = lex(lexer);
+
+    reset(input_);
+    jump_to(lexer.pos_);
+    integers_ = std::move(lexer.integers_);
+    if constexpr (Policy.retain_trivia) { trivia_ = std::move(lexer.trivia_); }
     return tokens;
 }
 
-auto Lexer::skip_whitespace() noexcept -> void {
-    while (std::isspace(current_byte_)) { read_character(); }
+template <LexerPolicy Policy>
+auto BasicLexer<Policy>::compact(const Token& token) const noexcept -> CompactToken {
+    const auto offset = token.type == TokenType::END
+                            ? std::min(pos_, input_.size())
+                            : static_cast<usize>(token.slice.data() - input_.data());
+    assert(offset + token.slice.size() <= MAX_SOURCE_SIZE);
+    return {static_cast<u32>(offset), static_cast<u32>(token.slice.size()), token.type};
+}
+
+template <LexerPolicy Policy> auto BasicLexer<Policy>::skip_whitespace() noexcept -> void {
+    if (char_is(current_byte_, CharClass::WHITESPACE)) {
+        jump_to(simd::skip_whitespace(input_, pos_));
+    }
+
+    // Comments are just more whitespace to lexers that do not emit them
+    if constexpr (!Policy.emit_comments) {
+        while (current_byte_ == '/' && peek_pos_ < input_.size() && input_[peek_pos_] == '/') {
+            jump_to(simd::find_either(input_, pos_, '\n', '\0'));
+            jump_to(simd::skip_whitespace(input_, pos_));
+        }
+    }
 }
 
-auto Lexer::lu_builtin(std::string_view ident) noexcept -> TokenType {
+template <LexerPolicy Policy>
+auto BasicLexer<Policy>::lu_builtin(std::string_view ident) noexcept -> TokenType {
     return get_builtin(ident)
         .transform([](const auto& keyword) noexcept -> TokenType { return keyword.second; })
         .value_or(TokenType::ILLEGAL);
 }
 
-auto Lexer::lu_ident(std::string_view ident) noexcept -> TokenType {
+template <LexerPolicy Policy>
+auto BasicLexer<Policy>::lu_ident(std::string_view ident) noexcept -> TokenType {
     return get_keyword(ident)
         .transform([](const auto& keyword) noexcept -> TokenType { return keyword.second; })
         .value_or(TokenType::IDENT);
 }
 
-auto Lexer::read_character(uint8_t n) noexcept -> void {
+template <LexerPolicy Policy> auto BasicLexer<Policy>::read_character(uint8_t n) noexcept -> void {
     for (uint8_t i = 0; i < n; ++i) {
         if (peek_pos_ >= input_.size()) {
             current_byte_ = '\0';
@@ -94,11 +308,13 @@ auto Lexer::read_character(uint8_t n) noexcept -> void {
             current_byte_ = input_[peek_pos_];
         }
 
-        if (current_byte_ == '\n') {
-            line_no_ += 1;
-            col_no_ = 0;
-        } else {
-            col_no_ += 1;
+        if constexpr (Policy.track_positions) {
+            if (current_byte_ == '\n') {
+                line_no_ += 1;
+                col_no_ = 0;
+            } else {
+                col_no_ += 1;
+            }
         }
 
         pos_ = peek_pos_;
@@ -106,42 +322,84 @@ auto Lexer::read_character(uint8_t n) noexcept -> void {
     }
 }
 
-auto Lexer::read_operator() const noexcept -> Optional<Token> {
-    const auto start_line = line_no_;
-    const auto start_col  = col_no_;
-
-    if (current_byte_ == '\0') { return Token{TokenType::END, {}, start_line, start_col}; }
+// Moves the lexer to the target position in a single step, fixing up the line and column counters
+// exactly as if every byte in between had been read individually.
+template <LexerPolicy Policy> auto BasicLexer<Policy>::jump_to(usize target) noexcept -> void {
+    if (target <= pos_) { return; }
 
-    size_t max_len      = 0;
-    auto   matched_type = TokenType::ILLEGAL;
-
-    // Try extending from length 1 up to the max operator size
-    for (size_t len = 1; len <= MAX_OPERATOR_LEN && pos_ + len <= input_.size(); ++len) {
-        const auto op = get_operator(input_.substr(pos_, len));
-        if (op) {
-            matched_type = op->second;
-            max_len      = len;
+    if constexpr (Policy.track_positions) {
+        const auto skipped  = input_.substr(pos_ + 1, target - pos_);
+        const auto newlines = simd::count(skipped, '\n');
+        if (newlines == 0) {
+            col_no_ += target - pos_;
+        } else {
+            line_no_ += newlines;
+            col_no_ = target - (pos_ + 1 + skipped.rfind('\n'));
         }
     }
 
+    pos_          = target;
+    peek_pos_     = target + 1;
+    current_byte_ = target < input_.size() ? input_[target] : '\0';
+}
+
+template <LexerPolicy Policy>
+auto BasicLexer<Policy>::read_operator() const noexcept -> Optional<Token> {
+    const auto start_line = line_no_;
+    const auto start_col  = col_no_;
+
+    const auto op = match_operator(input_.substr(pos_));
+    if (!op) { return nullopt; }
+
     // We cannot greedily consume the lexer here since the next token instruction handles that
-    if (max_len == 0) { return nullopt; }
-    return Token{matched_type, input_.substr(pos_, max_len), start_line, start_col};
+    return Token{op->second, op->first, start_line, start_col};
+}
+
+// Returns the byte length of the non-ASCII code point at the current position if it has the given
+// identifier property, or zero otherwise.
+template <LexerPolicy Policy>
+auto BasicLexer<Policy>::unicode_ident_length(bool (*property)(char32_t) noexcept) const noexcept
+    -> u8 {
+    const auto cp = unicode::decode(input_, pos_);
+    return cp && property(cp->value) ? cp->length : 0;
 }
 
-auto Lexer::read_ident(bool builtin) noexcept -> std::string_view {
+// Reads an identifier, assuming the current code point is a valid start (or '@' for builtins).
+//
+// ASCII identifiers never leave the character class table, so only non-ASCII bytes are decoded.
+template <LexerPolicy Policy> auto BasicLexer<Policy>::read_ident() noexcept -> std::string_view {
     const auto start = pos_;
 
-    auto passed_first = false;
-    while ((builtin && !passed_first && current_byte_ == '@') || std::isalpha(current_byte_) ||
-           current_byte_ == '_' || (passed_first && std::isdigit(current_byte_))) {
-        read_character();
-        passed_first = true;
+    read_character(unicode::is_ascii(current_byte_) ? 1
+                                                    : unicode_ident_length(unicode::is_xid_start));
+    while (true) {
+        if (char_is(current_byte_, CharClass::IDENT_CONTINUE)) {
+            read_character();
+            continue;
+        }
+
+        if (unicode::is_ascii(current_byte_)) { break; }
+        const auto length = unicode_ident_length(unicode::is_xid_continue);
+        if (length == 0) { break; }
+        read_character(length);
     }
 
     return input_.substr(start, pos_ - start);
 }
 
+// Appends digits worth `scale` to a decoded value, flagging overflow instead of wrapping.
+constexpr auto accumulate(u64& value, bool& overflow, u64 scale, u64 digits) noexcept -> void {
+    if (value > (std::numeric_limits<u64>::max() - digits) / scale) {
+        overflow = true;
+        return;
+    }
+    value = value * scale + digits;
+}
+
+constexpr auto digit_value(byte c) noexcept -> u64 {
+    return c <= '9' ? static_cast<u64>(c - '0') : static_cast<u64>((c | 0x20) - 'a' + 10);
+}
+
 enum class NumberSuffix : u8 {
     UNSIGNED = 1 << 0,
     WIDE     = 1 << 1,
@@ -161,13 +419,15 @@ constexpr auto suffix_has(NumberSuffix suffix, NumberSuffix flag) noexcept -> bo
     return static_cast<bool>(suffix & flag);
 }
 
-auto Lexer::read_number() noexcept -> Token {
+template <LexerPolicy Policy> auto BasicLexer<Policy>::read_number() noexcept -> Token {
     const auto start           = pos_;
     const auto start_line      = line_no_;
     const auto start_col       = col_no_;
     auto       passed_decimal  = false;
     auto       passed_exponent = false;
     auto       base{Base::DECIMAL};
+    u64        value    = 0;
+    bool       overflow = false;
 
     // Detect numeric prefix
     if (current_byte_ == '0' && peek_pos_ < input_.size()) {
@@ -200,13 +460,13 @@ auto Lexer::read_number() noexcept -> Token {
                 next = input_[p];
             }
 
-            if (!std::isdigit(next)) { break; }
+            if (!char_is(next, CharClass::DIGIT)) { break; }
 
             passed_exponent = true;
             read_character();
 
             if (current_byte_ == '+' || current_byte_ == '-') { read_character(); }
-            while (std::isdigit(current_byte_)) { read_character(); }
+            while (char_is(current_byte_, CharClass::DIGIT)) { read_character(); }
 
             continue;
         }
@@ -221,8 +481,27 @@ auto Lexer::read_number() noexcept -> Token {
             continue;
         }
 
-        // Normal digit
+        // Digits of the integer part are decoded as they are scanned, eight at a time when possible
         if (digit_in_base(c, base)) {
+            if (!Policy.decode_integers || passed_decimal) {
+                read_character();
+                continue;
+            }
+
+            if (pos_ + 8 <= input_.size()) {
+                const auto* digits = input_.data() + pos_;
+                const auto  eight  = base == Base::DECIMAL       ? swar::parse_eight_decimal(digits)
+                                     : base == Base::HEXADECIMAL ? swar::parse_eight_hex(digits)
+                                                                 : nullopt;
+                if (eight) {
+                    const u64 scale = base == Base::DECIMAL ? 100'000'000 : u64{1} << 32;
+                    accumulate(value, overflow, scale, *eight);
+                    jump_to(pos_ + 8);
+                    continue;
+                }
+            }
+
+            accumulate(value, overflow, std::to_underlying(base), digit_value(c));
             read_character();
             continue;
         }
@@ -299,12 +578,13 @@ auto Lexer::read_number() noexcept -> Token {
             }
         }
         type = static_cast<TokenType>(std::to_underlying(type) + offset);
+        if constexpr (Policy.decode_integers) { integers_.record(start, value, overflow); }
     }
 
     return {type, input_.substr(start, length), start_line, start_col};
 }
 
-auto Lexer::read_escape() noexcept -> byte {
+template <LexerPolicy Policy> auto BasicLexer<Policy>::read_escape() noexcept -> byte {
     read_character();
 
     switch (current_byte_) {
@@ -319,7 +599,7 @@ auto Lexer::read_escape() noexcept -> byte {
     }
 }
 
-auto Lexer::read_string() noexcept -> Token {
+template <LexerPolicy Policy> auto BasicLexer<Policy>::read_string() noexcept -> Token {
     const auto start      = pos_;
     const auto start_line = line_no_;
     const auto start_col  = col_no_;
@@ -344,7 +624,7 @@ auto Lexer::read_string() noexcept -> Token {
 }
 
 // Reads a multiline string from the token, assuming the '\\' operator has been consumed
-auto Lexer::read_multiline_string() noexcept -> Token {
+template <LexerPolicy Policy> auto BasicLexer<Policy>::read_multiline_string() noexcept -> Token {
     const auto start      = pos_;
     const auto start_line = line_no_;
     const auto start_col  = col_no_;
@@ -395,7 +675,7 @@ auto Lexer::read_multiline_string() noexcept -> Token {
 // Reads a byte literal returning an illegal token for malformed literals.
 //
 // Assumes that the surrounding single quotes have not been consumed.
-auto Lexer::read_byte_literal() noexcept -> Token {
+template <LexerPolicy Policy> auto BasicLexer<Policy>::read_byte_literal() noexcept -> Token {
     const auto start      = pos_;
     const auto start_line = line_no_;
     const auto start_col  = col_no_;
@@ -438,13 +718,21 @@ auto Lexer::read_byte_literal() noexcept -> Token {
 }
 
 // Reads a comment from the token, assuming the '//' operator has been consumed
-auto Lexer::read_comment() noexcept -> Token {
+template <LexerPolicy Policy> auto BasicLexer<Policy>::read_comment() noexcept -> Token {
     const auto start      = pos_;
     const auto start_line = line_no_;
     const auto start_col  = col_no_;
-    while (current_byte_ != '\n' && current_byte_ != '\0') { read_character(); }
+    jump_to(simd::find_either(input_, pos_, '\n', '\0'));
 
     return {TokenType::COMMENT, input_.substr(start, pos_ - start), start_line, start_col};
 }
 
+template class BasicLexer<LexerPolicy{}>;
+template class BasicLexer<PARSER_LEXER_POLICY>;
+template class BasicLexer<HIGHLIGHT_LEXER_POLICY>;
+template class BasicLexer<TRIVIA_LEXER_POLICY>;
+template class BasicLexer<LexerPolicy{}.without_positions()>;
+template class BasicLexer<PARSER_LEXER_POLICY.without_positions()>;
+template class BasicLexer<TRIVIA_LEXER_POLICY.without_positions()>;
+
 } // namespace conch
@@ -1,7 +1,7 @@
 #include <algorithm>
 #include <cassert>
-#include <cctype>
 
+#include "lexer/char_class.hpp"
 #include "lexer/keywords.hpp"
 #include "lexer/token.hpp"
 
@@ -20,8 +20,8 @@ auto digit_in_base(byte c, Base base) noexcept -> bool {
     switch (base) {
     case Base::BINARY:      return c == '0' || c == '1';
     case Base::OCTAL:       return c >= '0' && c <= '7';
-    case Base::DECIMAL:     return std::isdigit(c);
-    case Base::HEXADECIMAL: return std::isxdigit(c);
+    case Base::DECIMAL:     return char_is(c, CharClass::DIGIT);
+    case Base::HEXADECIMAL: return char_is(c, CharClass::HEX_DIGIT);
     default:                std::unreachable();
     }
 }
@@ -58,22 +58,6 @@ auto to_base(TokenType tt) noexcept -> Optional<Base> {
     }
 }
 
-auto misc_from_char(byte c) noexcept -> Optional<TokenType> {
-    switch (c) {
-    case ',': return TokenType::COMMA;
-    case ':': return TokenType::COLON;
-    case ';': return TokenType::SEMICOLON;
-    case '(': return TokenType::LPAREN;
-    case ')': return TokenType::RPAREN;
-    case '{': return TokenType::LBRACE;
-    case '}': return TokenType::RBRACE;
-    case '[': return TokenType::LBRACKET;
-    case ']': return TokenType::RBRACKET;
-    case '_': return TokenType::UNDERSCORE;
-    default:  return nullopt;
-    }
-}
-
 using SuffixMapping                = std::pair<bool (*)(TokenType), usize>;
 constexpr auto INT_SUFFIX_MAPPINGS = std::to_array<SuffixMapping>({
     {is_signed_int, 0},
@@ -132,13 +116,9 @@ auto Token::promote() const -> Expected<std::string, Diagnostic<TokenError>> {
     return builder;
 }
 
-auto Token::is_primitive() const noexcept -> bool {
-    return std::ranges::contains(ALL_PRIMITIVES, type);
-}
+auto Token::is_primitive() const noexcept -> bool { return conch::is_primitive(type); }
 
-auto Token::is_builtin() const noexcept -> bool {
-    return std::ranges::contains(ALL_BUILTINS, type, &Keyword::second);
-}
+auto Token::is_builtin() const noexcept -> bool { return conch::is_builtin(type); }
 
 auto Token::is_valid_ident() const noexcept -> bool {
     return type == TokenType::IDENT || type == TokenType::NORETURN ||
@@ -0,0 +1,80 @@
+#include <cassert>
+#include <memory>
+#include <span>
+#include <utility>
+
+#include "lexer/token_buffer.hpp"
+
+namespace conch {
+
+TokenBuffer::~TokenBuffer() { delete lines_.load(std::memory_order_relaxed); }
+
+TokenBuffer::TokenBuffer(const TokenBuffer& other)
+    : source_{other.source_}, types_{other.types_}, offsets_{other.offsets_},
+      lengths_{other.lengths_} {}
+
+TokenBuffer::TokenBuffer(TokenBuffer&& other) noexcept
+    : source_{other.source_}, types_{std::move(other.types_)},
+      offsets_{std::move(other.offsets_)}, lengths_{std::move(other.lengths_)},
+      lines_{other.lines_.exchange(nullptr, std::memory_order_relaxed)} {}
+
+auto TokenBuffer::operator=(const TokenBuffer& other) -> TokenBuffer& {
+    if (this != &other) { *this = TokenBuffer{other}; }
+    return *this;
+}
+
+auto TokenBuffer::operator=(TokenBuffer&& other) noexcept -> TokenBuffer& {
+    if (this == &other) { return *this; }
+    source_  = other.source_;
+    types_   = std::move(other.types_);
+    offsets_ = std::move(other.offsets_);
+    lengths_ = std::move(other.lengths_);
+    delete lines_.exchange(other.lines_.exchange(nullptr, std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+    return *this;
+}
+
+auto TokenBuffer::reserve(usize capacity) -> void {
+    types_.reserve(capacity);
+    offsets_.reserve(capacity);
+    lengths_.reserve(capacity);
+}
+
+auto TokenBuffer::push(TokenType type, usize offset, usize length) -> void {
+    assert(offset + length <= MAX_SOURCE_SIZE);
+    types_.push_back(type);
+    offsets_.push_back(static_cast<u32>(offset));
+    lengths_.push_back(static_cast<u32>(length));
+}
+
+auto TokenBuffer::append(const TokenBuffer& other, usize from, isize shift) -> void {
+    const auto from_idx = static_cast<std::ptrdiff_t>(from);
+    types_.insert(types_.end(), other.types_.begin() + from_idx, other.types_.end());
+    lengths_.insert(lengths_.end(), other.lengths_.begin() + from_idx, other.lengths_.end());
+
+    const auto old_size = offsets_.size();
+    offsets_.insert(offsets_.end(), other.offsets_.begin() + from_idx, other.offsets_.end());
+    if (shift == 0) { return; }
+    for (auto& offset : std::span{offsets_}.subspan(old_size)) {
+        offset = static_cast<u32>(static_cast<isize>(offset) + shift);
+    }
+}
+
+auto TokenBuffer::operator[](usize idx) const -> Token {
+    return compact(idx).expand(source_, line_index());
+}
+
+auto TokenBuffer::line_index() const -> const LineIndex& {
+    if (const auto* lines = lines_.load(std::memory_order_acquire)) { return *lines; }
+
+    // The index only depends on the source, so a thread that loses the race drops its own copy
+    auto        built    = std::make_unique<const LineIndex>(source_);
+    const auto* expected = static_cast<const LineIndex*>(nullptr);
+    if (lines_.compare_exchange_strong(
+            expected, built.get(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return *built.release();
+    }
+    return *expected;
+}
+
+} // namespace conch
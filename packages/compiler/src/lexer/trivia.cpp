@@ -0,0 +1,30 @@
+#include "lexer/trivia.hpp"
+
+namespace conch {
+
+auto TriviaTable::lexeme(usize idx) const noexcept -> std::string_view {
+    const auto from = spans_[idx].to;
+    const auto to   = idx + 1 < spans_.size() ? spans_[idx + 1].from : source_.size();
+    return source_.substr(from, to - from);
+}
+
+auto TriviaTable::pieces(usize idx) const -> std::vector<TriviaPiece> {
+    std::vector<TriviaPiece> pieces;
+    auto                     rest = leading(idx);
+    while (!rest.empty()) {
+        // Comments run up to their newline, which starts the next whitespace run
+        if (rest.starts_with("//")) {
+            const auto end = rest.find('\n');
+            pieces.push_back({TriviaKind::COMMENT, rest.substr(0, end)});
+            rest.remove_prefix(end == std::string_view::npos ? rest.size() : end);
+            continue;
+        }
+
+        const auto end = rest.find("//");
+        pieces.push_back({TriviaKind::WHITESPACE, rest.substr(0, end)});
+        rest.remove_prefix(end == std::string_view::npos ? rest.size() : end);
+    }
+    return pieces;
+}
+
+} // namespace conch
@@ -0,0 +1,27 @@
+#include <mutex>
+#include <utility>
+
+#include "parser/literal_pool.hpp"
+
+namespace conch {
+
+auto LiteralPool::intern(std::string_view literal) -> std::string_view {
+    const std::scoped_lock lock{mutex_};
+    if (const auto it = interned_.find(literal); it != interned_.end()) { return *it; }
+    return store(std::string{literal});
+}
+
+auto LiteralPool::intern(std::string&& literal) -> std::string_view {
+    const std::scoped_lock lock{mutex_};
+    if (const auto it = interned_.find(literal); it != interned_.end()) { return *it; }
+    return store(std::move(literal));
+}
+
+auto LiteralPool::store(std::string&& literal) -> std::string_view {
+    // Deque elements never move, which keeps even small-string buffers in place
+    const std::string_view stored{storage_.emplace_back(std::move(literal))};
+    interned_.insert(stored);
+    return stored;
+}
+
+} // namespace conch
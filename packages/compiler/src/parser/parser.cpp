@@ -1,11 +1,16 @@
 #include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory_resource>
 #include <ranges>
+#include <thread>
 #include <utility>
+#include <vector>
 
-#include <fmt/format.h>
 #include <magic_enum/magic_enum.hpp>
 
 #include "array.hpp"
+#include "parallel.hpp"
 
 #include "parser/parser.hpp"
 #include "parser/precedence.hpp"
@@ -14,128 +19,469 @@
 #include "lexer/token.hpp"
 
 #include "ast/ast.hpp"
+#include "ast/flat.hpp"
+#include "ast/shift.hpp"
 
 namespace conch {
 
-Parser::Checkpoint::Checkpoint(const Parser& parser) noexcept
-    : snapshot_{parser.lexer_}, current_{parser.current_token_}, peek_{parser.peek_token_} {}
+Parser::Parser(const DeferredRange& range)
+    : input_{range.source->stream->source}, stream_{range.source->stream}, cursor_{range.begin},
+      depth_{range.depth}, literals_{range.source->literals}, arena_{range.source->arena},
+      options_{range.source->options}, resumed_{range.source} {
+    sync();
+}
+
+auto Parser::reset(std::string_view input) -> void {
+    auto literals = std::move(literals_);
+    *this         = Parser{input, options_, std::move(literals)};
+}
+
+auto Parser::reset(Rc<const std::string> input) -> void {
+    auto literals = std::move(literals_);
+    *this         = Parser{std::move(input), options_, std::move(literals)};
+}
+
+auto Parser::intern(std::string&& literal) -> std::string_view {
+    return literals()->intern(std::move(literal));
+}
+
+auto Parser::literals() -> const Rc<LiteralPool>& {
+    if (!literals_) { literals_ = make_rc<LiteralPool>(); }
+    return literals_;
+}
 
-auto Parser::reset(std::string_view input) noexcept -> void { *this = Parser{input}; }
+auto Parser::arena() -> const Rc<Arena>& {
+    if (!arena_) { arena_ = make_rc<Arena>(); }
+    return arena_;
+}
+
+auto Parser::deferred_source() -> const DeferredSource& {
+    if (resumed_) { return *resumed_; }
+    if (!deferred_) {
+        deferred_ = make_rc<DeferredSource>(stream_, literals(), arena(), options_);
+    }
+    return *deferred_;
+}
+
+auto Parser::tokenize() -> void {
+    auto stream    = make_rc<TokenStream>();
+    stream->source = input_;
+
+    ParserLexer lexer{input_};
+    auto&       tokens = stream->tokens;
+    do { tokens.push_back(lexer.advance()); } while (tokens.back().type != TokenType::END);
+
+    stream->integers = lexer.integers();
+    stream_          = std::move(stream);
+    sync();
+}
+
+auto Parser::rewind() -> void {
+    if (!stream_) {
+        tokenize();
+    } else {
+        cursor_ = 0;
+        sync();
+    }
+
+    lookahead_ = std::min(cursor_ + 1, stream_->tokens.size() - 1);
+    depth_     = 0;
+    arena_     = {};
+    deferred_  = {};
+    memo_.clear();
+}
+
+auto Parser::retain_sources(ast::AST& ast) const -> void {
+    if (owned_input_) { ast.retain(owned_input_); }
+    if (deferred_) { ast.retain_deferred(deferred_); }
+}
 
 auto Parser::advance(uint8_t times) noexcept -> const Token& {
-    for (uint8_t i = 0; i < times; ++i) {
-        if (current_token_.type == TokenType::END &&
-            (input_.empty() && current_token_.is_at_start())) {
+    if (!stream_) { return current_token_; }
+    const auto& tokens = stream_->tokens;
+
+    cursor_ = std::min(cursor_ + times, tokens.size() - 1);
+    sync();
+    return current_token_;
+}
+
+auto Parser::consume() -> std::pair<ast::AST, Diagnostics> {
+    rewind();
+    ast::AST    ast{arena()};
+    Diagnostics diagnostics;
+
+    while (!current_token_is(TokenType::END)) { parse_top_level(ast, diagnostics); }
+    retain_sources(ast);
+    return {std::move(ast), std::move(diagnostics)};
+}
+
+auto Parser::consume_parallel(const ParallelParseOptions& options)
+    -> std::pair<ast::AST, Diagnostics> {
+    rewind();
+    ast::AST    ast{arena()};
+    Diagnostics diagnostics;
+
+    // Split after semicolons outside of any brackets, keeping every task above the minimum size
+    const auto&        tokens = stream_->tokens;
+    const auto         end    = tokens.size() - 1;
+    std::vector<usize> bounds{0};
+    usize              depth = 0;
+    for (usize i = 0; i < end; ++i) {
+        switch (tokens[i].type) {
+        case TokenType::LPAREN:
+        case TokenType::LBRACE:
+        case TokenType::LBRACKET: depth += 1; break;
+        case TokenType::RPAREN:
+        case TokenType::RBRACE:
+        case TokenType::RBRACKET: depth -= depth > 0 ? 1 : 0; break;
+        case TokenType::SEMICOLON:
+            if (depth == 0 && i + 1 - bounds.back() >= options.min_task_tokens) {
+                bounds.push_back(i + 1);
+            }
             break;
+        default: break;
         }
+    }
+    if (bounds.back() == end) { bounds.pop_back(); }
+    bounds.push_back(end);
+
+    const auto tasks   = bounds.size() - 1;
+    const auto threads = options.threads == 0
+                             ? std::max(usize{1}, usize{std::thread::hardware_concurrency()})
+                             : options.threads;
+    if (tasks <= 1 || threads <= 1) {
+        while (!current_token_is(TokenType::END)) { parse_top_level(ast, diagnostics); }
+        retain_sources(ast);
+        return {std::move(ast), std::move(diagnostics)};
+    }
 
-        current_token_ = peek_token_;
-        peek_token_    = lexer_.advance();
+    struct Task {
+        ast::AST    ast;
+        Diagnostics diagnostics;
+        usize       exit{0};
+    };
+
+    // Workers claim the next unparsed task until none are left, so uneven tasks balance out
+    std::vector<Task>  speculated(tasks);
+    std::atomic<usize> next{0};
+    (void)literals();
+    const auto work = [&] {
+        auto               worker = fork();
+        std::vector<usize> claimed;
+        for (auto i = next.fetch_add(1); i < tasks; i = next.fetch_add(1)) {
+            claimed.push_back(i);
+            auto& task = speculated[i];
+            task.ast   = ast::AST{worker.arena()};
+
+            worker.cursor_ = bounds[i];
+            worker.sync();
+            while (!worker.current_token_is(TokenType::END) && worker.cursor_ < bounds[i + 1]) {
+                worker.parse_top_level(task.ast, task.diagnostics);
+            }
+            task.exit = worker.cursor_;
+        }
+
+        // Each worker skips blocks into its own arena, so every task it parsed retains its source
+        if (!worker.deferred_) { return; }
+        for (const auto i : claimed) { speculated[i].ast.retain_deferred(worker.deferred_); }
+    };
+
+    parallel::fork_join(std::min(threads, tasks), [&](usize) { work(); });
+
+    // A task is only right if the statements before it ended exactly where it starts
+    for (usize i = 0; i < tasks && !current_token_is(TokenType::END); ++i) {
+        if (cursor_ >= bounds[i + 1]) { continue; }
+
+        if (cursor_ == bounds[i]) {
+            auto& task = speculated[i];
+            ast.append(std::move(task.ast));
+            std::ranges::move(task.diagnostics, std::back_inserter(diagnostics));
+            cursor_ = task.exit;
+            sync();
+        } else {
+            while (!current_token_is(TokenType::END) && cursor_ < bounds[i + 1]) {
+                parse_top_level(ast, diagnostics);
+            }
+        }
     }
-    return current_token_;
+
+    retain_sources(ast);
+    return {std::move(ast), std::move(diagnostics)};
 }
 
-auto Parser::consume() -> std::pair<ast::AST, Diagnostics> {
-    reset(input_);
-    ast::AST    ast;
+auto Parser::reparse(ast::AST&& previous, const TokenStream& previous_stream, const TextEdit& edit)
+    -> std::pair<ast::AST, Diagnostics> {
+    rewind();
+    ast::AST    ast{arena()};
     Diagnostics diagnostics;
 
+    const auto& before  = previous_stream.tokens;
+    const auto& after   = stream_->tokens;
+    const auto  matches = [&](const Token& old_token, const Token& new_token, isize shift) {
+        const auto old_offset = static_cast<isize>(previous_stream.offset(old_token));
+        const auto new_offset = static_cast<isize>(stream_->offset(new_token));
+        return old_token.type == new_token.type && old_offset + shift == new_offset &&
+               old_token.slice.size() == new_token.slice.size();
+    };
+
+    // Tokens in front of the edit are the same as long as the lexer still produced them in place
+    const auto limit  = std::min(before.size(), after.size()) - 1;
+    usize      prefix = 0;
+    while (prefix < limit && matches(before[prefix], after[prefix], 0) &&
+           previous_stream.offset(before[prefix]) + before[prefix].slice.size() <= edit.offset) {
+        prefix += 1;
+    }
+
+    // Tokens behind the edit must shift with the text, moving lines and columns along with it when
+    // the edit changed them. End tokens always match.
+    const auto edit_end = edit.offset + edit.length;
+    usize      suffix   = 1;
+    while (prefix + suffix <= limit) {
+        const auto& old_token = before[before.size() - 1 - suffix];
+        if (previous_stream.offset(old_token) < edit_end ||
+            !matches(old_token, after[after.size() - 1 - suffix], edit.delta())) {
+            break;
+        }
+        suffix += 1;
+    }
+
+    const auto extents    = previous.extents();
+    const auto old_suffix = before.size() - suffix;
+    const auto new_suffix = after.size() - suffix;
+
+    // Reused nodes are moved into the new source, so later edits only ever shift from the last one
+    auto shift = old_suffix + 1 < before.size()
+                     ? ast::TokenShift::between(previous_stream.source,
+                                                before[old_suffix],
+                                                stream_->source,
+                                                after[new_suffix])
+                     : ast::TokenShift{.from   = previous_stream.source,
+                                       .to     = stream_->source,
+                                       .behind = previous_stream.source.size()};
+    shift.behind_index = old_suffix;
+    shift.tokens       = static_cast<isize>(new_suffix) - static_cast<isize>(old_suffix);
+    const auto moved   = [&](usize idx) { return shift.apply(idx); };
+
+    // Skipped bodies of reused statements stay skipped, resuming from this parse's tokens instead
+    if (options_.lazy_function_bodies) { shift.deferred = &deferred_source(); }
+
+    usize next = 0;
     while (!current_token_is(TokenType::END)) {
-        // Advance through any amount of semicolons
-        const auto skip = [](TokenType tt) { return tt == TokenType::SEMICOLON; };
-        if (skip(current_token_.type)) { while (skip(advance().type)); }
-        if (current_token_is(TokenType::END)) { break; }
-
-        // Comments are entirely discarded from the tree
-        if (!current_token_is(TokenType::COMMENT)) {
-            auto stmt = parse_statement();
-            if (stmt) {
-                ast.emplace_back(std::move(*stmt));
-            } else {
-                diagnostics.emplace_back(std::move(stmt.error()));
-
-                // Errors should advance up to next logical end to prevent useless errors
-                const auto stop_condition = [](TokenType tt) {
-                    switch (tt) {
-                    case TokenType::RBRACE:
-                    case TokenType::SEMICOLON:
-                    case TokenType::END:       return true;
-                    default:                   return false;
-                    }
-                };
-                while (!stop_condition(advance().type));
+        // Statements start at the same place they did before only within unchanged tokens
+        Optional<usize> start;
+        if (cursor_ < prefix) {
+            start = cursor_;
+        } else if (cursor_ >= new_suffix) {
+            start = cursor_ - new_suffix + old_suffix;
+        }
+
+        if (start && extents.size() == previous.size()) {
+            while (next < extents.size() && extents[next].begin < *start) { next += 1; }
+            if (next < extents.size() && extents[next].begin == *start) {
+                // Statements that never looked at the edit move over whole, while one holding it
+                // only has the innermost block around the edit parsed again
+                const auto&     extent = extents[next];
+                Optional<usize> lookahead;
+                if (extent.lookahead < prefix || extent.begin >= old_suffix) {
+                    ast::shift_tokens(*previous[next], shift);
+                    lookahead = moved(extent.lookahead);
+                } else {
+                    lookahead =
+                        reparse_block(*previous[next], previous_stream, extent, prefix, shift);
+                }
+
+                if (lookahead) {
+                    ast.push_back(std::move(previous[next]),
+                                  {moved(extent.begin), moved(extent.end), *lookahead});
+                    cursor_ = moved(extent.end);
+                    sync();
+                    continue;
+                }
+
+                // A block that failed to parse left the cursor inside of the statement
+                cursor_ = moved(extent.begin);
+                sync();
             }
         }
-        advance();
+
+        parse_top_level(ast, diagnostics);
     }
 
+    ast.adopt(std::move(previous));
+    retain_sources(ast);
     return {std::move(ast), std::move(diagnostics)};
 }
 
-auto Parser::expect_peek(TokenType expected) -> Expected<std::monostate, ParserDiagnostic> {
-    if (peek_token_is(expected)) {
-        advance();
-        return {};
+auto Parser::reparse_block(const ast::Node&        statement,
+                           const TokenStream&      previous_stream,
+                           const ast::AST::Extent& extent,
+                           usize                   prefix,
+                           const ast::TokenShift&  shift) -> Optional<usize> {
+    const auto& before = previous_stream.tokens;
+    const auto& after  = stream_->tokens;
+    const auto  match  = [](const std::vector<Token>& tokens, usize open) -> usize {
+        usize depth = 0;
+        for (auto i = open; tokens[i].type != TokenType::END; ++i) {
+            if (tokens[i].type == TokenType::LBRACE) {
+                depth += 1;
+            } else if (tokens[i].type == TokenType::RBRACE && --depth == 0) {
+                return i;
+            }
+        }
+        return tokens.size();
+    };
+
+    // The braces still open where the edit starts enclose it, with the innermost one last
+    std::vector<usize> open;
+    for (auto i = extent.begin; i < prefix; ++i) {
+        if (before[i].type == TokenType::LBRACE) {
+            open.push_back(i);
+        } else if (before[i].type == TokenType::RBRACE && !open.empty()) {
+            open.pop_back();
+        }
     }
-    return Unexpected{peek_error(expected)};
-}
 
-auto Parser::poll_current_precedence() const noexcept -> Precedence {
-    return get_binding(current_token_.type)
-        .transform([](const auto& binding) { return binding.second; })
-        .value_or(Precedence::LOWEST);
+    for (const auto brace : std::views::reverse(open)) {
+        // The edit has to end inside of the braces, which still have to pair up around it
+        const auto close = match(before, brace);
+        if (close == before.size() || close < shift.behind_index ||
+            match(after, brace) != shift.apply(close)) {
+            continue;
+        }
+
+        // Skipped bodies only depend on their braces, so one around the edit is kept skipped
+        const auto found = ast::find_block(statement, before[brace]);
+        if (found.deferred && shift.deferred) {
+            ast::shift_tokens(statement, shift);
+            return shift.apply(extent.lookahead);
+        }
+        if (!found.block) { continue; }
+
+        // A block's statements depend on nothing but its tokens and the depth they are parsed at
+        cursor_    = brace;
+        depth_     = found.block->get_depth();
+        lookahead_ = brace;
+        sync();
+        auto block = ast::BlockStatement::parse(*this);
+        depth_     = 0;
+        if (!block || cursor_ != shift.apply(close)) { return nullopt; }
+
+        const auto lookahead = std::max(shift.apply(extent.lookahead), lookahead_);
+        auto       parsed    = box_into<ast::BlockStatement>(std::move(*block));
+        ast::shift_tokens(statement, shift, *found.block, std::move(*parsed));
+        return lookahead;
+    }
+    return nullopt;
 }
 
-auto Parser::poll_peek_precedence() const noexcept -> Precedence {
-    return get_binding(peek_token_.type)
-        .transform([](const auto& binding) { return binding.second; })
-        .value_or(Precedence::LOWEST);
+auto Parser::consume_flat() -> std::pair<ast::FlatAST, Diagnostics> {
+    auto [ast, diagnostics] = consume();
+    auto [flat, failures]   = ast::FlatAST::lower(ast, input_, stream_->tokens);
+    std::ranges::move(failures, std::back_inserter(diagnostics));
+    return {std::move(flat), std::move(diagnostics)};
 }
 
-auto Parser::parse_statement() -> Expected<Box<ast::Statement>, ParserDiagnostic> {
-    switch (current_token_.type) {
-    case TokenType::VAR:
-    case TokenType::CONST:
-    case TokenType::COMPTIME:
-    case TokenType::PRIVATE:
-    case TokenType::EXTERN:
-    case TokenType::EXPORT:     return ast::DeclStatement::parse(*this);
-    case TokenType::BREAK:
-    case TokenType::RETURN:
-    case TokenType::CONTINUE:   return ast::JumpStatement::parse(*this);
-    case TokenType::DEFER:      return ast::DeferStatement::parse(*this);
-    case TokenType::IMPORT:     return ast::ImportStatement::parse(*this);
-    case TokenType::LBRACE:     return ast::BlockStatement::parse(*this);
-    case TokenType::UNDERSCORE: return ast::DiscardStatement::parse(*this);
-    case TokenType::USING:      return ast::UsingStatement::parse(*this);
-    default:                    return ast::ExpressionStatement::parse(*this);
-    }
+auto Parser::fork() -> Parser {
+    Parser worker;
+    worker.input_    = input_;
+    worker.stream_   = stream_;
+    worker.literals_ = literals();
+    worker.options_  = options_;
+    worker.sync();
+    return worker;
 }
 
-auto Parser::parse_expression(Precedence precedence)
-    -> Expected<Box<ast::Expression>, ParserDiagnostic> {
-    if (current_token_is(TokenType::END)) {
-        return make_parser_unexpected(ParserError::END_OF_TOKEN_STREAM, current_token_);
+auto Parser::parse_top_level(ast::AST& ast, Diagnostics& diagnostics) -> void {
+    const auto begin = cursor_;
+    lookahead_       = std::min(cursor_ + 1, stream_->tokens.size() - 1);
+
+    // Advance through any amount of semicolons
+    const auto skip = [](TokenType tt) { return tt == TokenType::SEMICOLON; };
+    if (skip(current_token_.type)) { while (skip(advance().type)); }
+    if (current_token_is(TokenType::END)) { return; }
+
+    // Comments never reach the parser, the lexer skips them like whitespace
+    auto stmt = parse_statement();
+    if (stmt) {
+        const auto lookahead = lookahead_;
+        advance();
+        ast.push_back(std::move(*stmt), {begin, cursor_, lookahead});
+        return;
     }
+    diagnostics.emplace_back(std::move(stmt.error()));
+
+    // Errors should advance up to next logical end to prevent useless errors
+    const auto stop_condition = [](TokenType tt) {
+        switch (tt) {
+        case TokenType::RBRACE:
+        case TokenType::SEMICOLON:
+        case TokenType::END:       return true;
+        default:                   return false;
+        }
+    };
+    while (!stop_condition(advance().type));
+    advance();
+}
 
-    const auto& prefix = poll_prefix_fn(current_token_.type);
-    if (!prefix) {
-        return make_parser_unexpected(fmt::format("No prefix parse function for {}({}) found",
-                                                  magic_enum::enum_name(current_token_.type),
-                                                  current_token_.slice),
-                                      ParserError::MISSING_PREFIX_PARSER,
-                                      current_token_);
+auto Parser::defer_block() -> Optional<DeferredRange> {
+    const auto& tokens = stream_->tokens;
+    const auto  begin  = cursor_;
+
+    usize depth = 0;
+    for (auto i = begin; tokens[i].type != TokenType::END; ++i) {
+        if (tokens[i].type == TokenType::LBRACE) {
+            depth += 1;
+        } else if (tokens[i].type == TokenType::RBRACE && --depth == 0) {
+            const auto& source = deferred_source();
+            cursor_            = i;
+            sync();
+            return DeferredRange{&source, begin, i, depth_};
+        }
     }
-    auto lhs_expression = TRY((*prefix)(*this));
+    return nullopt;
+}
 
-    while (!peek_token_is(TokenType::SEMICOLON) && precedence < poll_peek_precedence()) {
-        const auto& infix = poll_infix_fn(peek_token_.type);
-        if (!infix) { break; }
+auto Parser::expect_peek(TokenType expected) -> Expected<std::monostate, ParserDiagnostic> {
+    if (peek_token_is(expected)) {
         advance();
-        lhs_expression = TRY((*infix)(*this, std::move(lhs_expression)));
+        return {};
     }
+    return Unexpected{peek_error(expected)};
+}
 
-    return lhs_expression;
+auto Parser::poll_current_precedence() const noexcept -> Precedence {
+    return binding_power(current_token_.type);
+}
+
+auto Parser::poll_peek_precedence() const noexcept -> Precedence {
+    return binding_power(peek_token_.type);
+}
+
+auto Parser::parse_statement() -> Expected<Box<ast::Statement>, ParserDiagnostic> {
+    // Blocks nest through here without ever parsing an expression
+    const auto depth = depth_;
+    TRY(nest());
+    auto statement = [&]() -> Expected<Box<ast::Statement>, ParserDiagnostic> {
+        switch (current_token_.type) {
+        case TokenType::VAR:
+        case TokenType::CONST:
+        case TokenType::COMPTIME:
+        case TokenType::PRIVATE:
+        case TokenType::EXTERN:
+        case TokenType::EXPORT:     return ast::DeclStatement::parse(*this);
+        case TokenType::BREAK:
+        case TokenType::RETURN:
+        case TokenType::CONTINUE:   return ast::JumpStatement::parse(*this);
+        case TokenType::DEFER:      return ast::DeferStatement::parse(*this);
+        case TokenType::IMPORT:     return ast::ImportStatement::parse(*this);
+        case TokenType::LBRACE:     return ast::BlockStatement::parse(*this);
+        case TokenType::UNDERSCORE: return ast::DiscardStatement::parse(*this);
+        case TokenType::USING:      return ast::UsingStatement::parse(*this);
+        default:                    return ast::ExpressionStatement::parse(*this);
+        }
+    }();
+    depth_ = depth;
+    return statement;
 }
 
 [[nodiscard]] auto Parser::parse_restricted_statement(ParserError error)
@@ -241,74 +587,243 @@ constexpr auto PREFIX_FNS = []() {
     constexpr auto materialized_builtins =
         array::materialize_sized_view<ALL_BUILTINS.size()>(builtins_prefixes);
 
-    auto prefix_fns = array::concat(
+    return array::concat(
         initial_prefixes, materialized_primitives, materialized_builtins, int_prefixes);
-    std::ranges::sort(prefix_fns, {}, &PrefixPair::first);
-    return prefix_fns;
 }();
 
-constexpr auto Parser::poll_prefix_fn(TokenType tt) noexcept -> Optional<const PrefixFn&> {
-    const auto it = std::ranges::lower_bound(PREFIX_FNS, tt, {}, &PrefixPair::first);
-    if (it == PREFIX_FNS.end() || it->first != tt) { return nullopt; }
-    return Optional<const PrefixFn&>{it->second};
+using InfixPair          = std::pair<TokenType, Parser::InfixFn>;
+constexpr auto INFIX_FNS = std::to_array<InfixPair>({
+    {TokenType::PLUS, ast::BinaryExpression::parse},
+    {TokenType::MINUS, ast::BinaryExpression::parse},
+    {TokenType::STAR, ast::BinaryExpression::parse},
+    {TokenType::SLASH, ast::BinaryExpression::parse},
+    {TokenType::PERCENT, ast::BinaryExpression::parse},
+    {TokenType::LT, ast::BinaryExpression::parse},
+    {TokenType::LT_EQ, ast::BinaryExpression::parse},
+    {TokenType::GT, ast::BinaryExpression::parse},
+    {TokenType::GT_EQ, ast::BinaryExpression::parse},
+    {TokenType::EQ, ast::BinaryExpression::parse},
+    {TokenType::NEQ, ast::BinaryExpression::parse},
+    {TokenType::BOOLEAN_AND, ast::BinaryExpression::parse},
+    {TokenType::BOOLEAN_OR, ast::BinaryExpression::parse},
+    {TokenType::BW_AND, ast::BinaryExpression::parse},
+    {TokenType::BW_OR, ast::BinaryExpression::parse},
+    {TokenType::XOR, ast::BinaryExpression::parse},
+    {TokenType::SHR, ast::BinaryExpression::parse},
+    {TokenType::SHL, ast::BinaryExpression::parse},
+    {TokenType::DOT, ast::DotExpression::parse},
+    {TokenType::DOT_DOT, ast::RangeExpression::parse},
+    {TokenType::DOT_DOT_EQ, ast::RangeExpression::parse},
+    {TokenType::ARROW, ast::ImplicitDereferenceExpression::parse},
+    {TokenType::LPAREN, ast::CallExpression::parse},
+    {TokenType::LBRACKET, ast::IndexExpression::parse},
+    {TokenType::ASSIGN, ast::AssignmentExpression::parse},
+    {TokenType::PLUS_ASSIGN, ast::AssignmentExpression::parse},
+    {TokenType::MINUS_ASSIGN, ast::AssignmentExpression::parse},
+    {TokenType::STAR_ASSIGN, ast::AssignmentExpression::parse},
+    {TokenType::SLASH_ASSIGN, ast::AssignmentExpression::parse},
+    {TokenType::PERCENT_ASSIGN, ast::AssignmentExpression::parse},
+    {TokenType::BW_AND_ASSIGN, ast::AssignmentExpression::parse},
+    {TokenType::BW_OR_ASSIGN, ast::AssignmentExpression::parse},
+    {TokenType::SHL_ASSIGN, ast::AssignmentExpression::parse},
+    {TokenType::SHR_ASSIGN, ast::AssignmentExpression::parse},
+    {TokenType::NOT_ASSIGN, ast::AssignmentExpression::parse},
+    {TokenType::XOR_ASSIGN, ast::AssignmentExpression::parse},
+    {TokenType::COLON_COLON, ast::ScopeResolutionExpression::parse},
+});
+
+using PrefixBuilder = Box<ast::Expression> (*)(Parser&, const Token&, Box<ast::Expression>);
+using InfixBuilder  = Box<ast::Expression> (*)(Parser&,
+                                              Box<ast::Expression>,
+                                              TokenType,
+                                              Box<ast::Expression>);
+
+template <typename Node>
+constexpr auto prefix_operator() noexcept -> std::pair<Parser::PrefixFn, PrefixBuilder> {
+    return {Node::parse, Node::make};
 }
 
-using InfixPair          = std::pair<TokenType, Parser::InfixFn>;
-constexpr auto INFIX_FNS = []() {
-    auto infix_fns = std::to_array<InfixPair>({
-        {TokenType::PLUS, ast::BinaryExpression::parse},
-        {TokenType::MINUS, ast::BinaryExpression::parse},
-        {TokenType::STAR, ast::BinaryExpression::parse},
-        {TokenType::SLASH, ast::BinaryExpression::parse},
-        {TokenType::PERCENT, ast::BinaryExpression::parse},
-        {TokenType::LT, ast::BinaryExpression::parse},
-        {TokenType::LT_EQ, ast::BinaryExpression::parse},
-        {TokenType::GT, ast::BinaryExpression::parse},
-        {TokenType::GT_EQ, ast::BinaryExpression::parse},
-        {TokenType::EQ, ast::BinaryExpression::parse},
-        {TokenType::NEQ, ast::BinaryExpression::parse},
-        {TokenType::BOOLEAN_AND, ast::BinaryExpression::parse},
-        {TokenType::BOOLEAN_OR, ast::BinaryExpression::parse},
-        {TokenType::BW_AND, ast::BinaryExpression::parse},
-        {TokenType::BW_OR, ast::BinaryExpression::parse},
-        {TokenType::XOR, ast::BinaryExpression::parse},
-        {TokenType::SHR, ast::BinaryExpression::parse},
-        {TokenType::SHL, ast::BinaryExpression::parse},
-        {TokenType::DOT, ast::DotExpression::parse},
-        {TokenType::DOT_DOT, ast::RangeExpression::parse},
-        {TokenType::DOT_DOT_EQ, ast::RangeExpression::parse},
-        {TokenType::ARROW, ast::ImplicitDereferenceExpression::parse},
-        {TokenType::LPAREN, ast::CallExpression::parse},
-        {TokenType::LBRACKET, ast::IndexExpression::parse},
-        {TokenType::ASSIGN, ast::AssignmentExpression::parse},
-        {TokenType::PLUS_ASSIGN, ast::AssignmentExpression::parse},
-        {TokenType::MINUS_ASSIGN, ast::AssignmentExpression::parse},
-        {TokenType::STAR_ASSIGN, ast::AssignmentExpression::parse},
-        {TokenType::SLASH_ASSIGN, ast::AssignmentExpression::parse},
-        {TokenType::PERCENT_ASSIGN, ast::AssignmentExpression::parse},
-        {TokenType::BW_AND_ASSIGN, ast::AssignmentExpression::parse},
-        {TokenType::BW_OR_ASSIGN, ast::AssignmentExpression::parse},
-        {TokenType::SHL_ASSIGN, ast::AssignmentExpression::parse},
-        {TokenType::SHR_ASSIGN, ast::AssignmentExpression::parse},
-        {TokenType::NOT_ASSIGN, ast::AssignmentExpression::parse},
-        {TokenType::XOR_ASSIGN, ast::AssignmentExpression::parse},
-        {TokenType::COLON_COLON, ast::ScopeResolutionExpression::parse},
-    });
+template <typename Node>
+constexpr auto infix_operator() noexcept -> std::pair<Parser::InfixFn, InfixBuilder> {
+    return {Node::parse, Node::make};
+}
 
-    std::ranges::sort(infix_fns, {}, &InfixPair::first);
-    return infix_fns;
+// Operators whose operands the expression loop parses itself, found by their parse functions
+constexpr auto PREFIX_OPERATORS = std::to_array({
+    prefix_operator<ast::UnaryExpression>(),
+    prefix_operator<ast::ReferenceExpression>(),
+    prefix_operator<ast::DereferenceExpression>(),
+    prefix_operator<ast::ImplicitAccessExpression>(),
+});
+
+constexpr auto INFIX_OPERATORS = std::to_array({
+    infix_operator<ast::AssignmentExpression>(),
+    infix_operator<ast::BinaryExpression>(),
+    infix_operator<ast::DotExpression>(),
+    infix_operator<ast::RangeExpression>(),
+    infix_operator<ast::ImplicitDereferenceExpression>(),
+});
+
+// Everything the Pratt loop needs to know about a token, so each step is a single indexed load.
+struct ParseRule {
+    Parser::PrefixFn prefix{nullptr};
+    Parser::InfixFn  infix{nullptr};
+    Precedence       precedence{Precedence::LOWEST};
+
+    // Set when the loop folds the operator itself instead of calling its parse function
+    PrefixBuilder prefix_operator{nullptr};
+    InfixBuilder  infix_operator{nullptr};
+    bool          group{false};
+};
+
+constexpr auto PARSE_RULES = []() {
+    std::array<ParseRule, TOKEN_TYPE_COUNT> rules{};
+    for (const auto& [tt, fn] : PREFIX_FNS) { rules[std::to_underlying(tt)].prefix = fn; }
+    for (const auto& [tt, fn] : INFIX_FNS) { rules[std::to_underlying(tt)].infix = fn; }
+    for (const auto& [tt, precedence] : ALL_BINDINGS) {
+        rules[std::to_underlying(tt)].precedence = precedence;
+    }
+
+    for (auto& rule : rules) {
+        for (const auto& [parse, make] : PREFIX_OPERATORS) {
+            if (rule.prefix == parse) { rule.prefix_operator = make; }
+        }
+        for (const auto& [parse, make] : INFIX_OPERATORS) {
+            if (rule.infix == parse) { rule.infix_operator = make; }
+        }
+        rule.group = rule.prefix == ast::GroupedExpression::parse;
+    }
+    return rules;
 }();
 
+constexpr auto parse_rule(TokenType tt) noexcept -> const ParseRule& {
+    return PARSE_RULES[std::to_underlying(tt)];
+}
+
+constexpr auto Parser::poll_prefix_fn(TokenType tt) noexcept -> Optional<const PrefixFn&> {
+    const auto& rule = parse_rule(tt);
+    if (!rule.prefix) { return nullopt; }
+    return Optional<const PrefixFn&>{rule.prefix};
+}
+
 constexpr auto Parser::poll_infix_fn(TokenType tt) noexcept -> Optional<const InfixFn&> {
-    const auto it = std::ranges::lower_bound(INFIX_FNS, tt, {}, &InfixPair::first);
-    if (it == INFIX_FNS.end() || it->first != tt) { return nullopt; }
-    return Optional<const InfixFn&>{it->second};
+    const auto& rule = parse_rule(tt);
+    if (!rule.infix) { return nullopt; }
+    return Optional<const InfixFn&>{rule.infix};
+}
+
+auto Parser::parse_expression(Precedence precedence)
+    -> Expected<Box<ast::Expression>, ParserDiagnostic> {
+    // Calls, indexing and other nodes with inner expressions still recurse through here, so the
+    // depth is restored however the loop exits
+    const auto depth      = depth_;
+    auto       expression = parse_operators(precedence);
+    depth_                = depth;
+    return expression;
+}
+
+auto Parser::parse_operators(Precedence precedence)
+    -> Expected<Box<ast::Expression>, ParserDiagnostic> {
+    // An operator waiting on its operand, holding what a recursive parser would keep in its frame.
+    // Groups have neither builder and only wait on their closing parenthesis.
+    struct Pending {
+        Token                token;
+        Precedence           precedence;
+        PrefixBuilder        prefix;
+        InfixBuilder         infix;
+        Box<ast::Expression> lhs;
+    };
+
+    // Ordinary expressions never outgrow the buffer, so only deep nesting touches the heap
+    constexpr usize INLINE_PENDING = 8;
+    alignas(Pending) std::array<byte, INLINE_PENDING * sizeof(Pending)> buffer;
+    std::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size()};
+    std::pmr::vector<Pending>           pending{&resource};
+    pending.reserve(INLINE_PENDING);
+
+    TRY(nest());
+    while (true) {
+        // Descend through prefix operators and groups until reaching an operand
+        while (true) {
+            if (current_token_is(TokenType::END)) {
+                return make_parser_unexpected(ParserError::END_OF_TOKEN_STREAM, current_token_);
+            }
+
+            const auto& rule = parse_rule(current_token_.type);
+            if (!rule.prefix_operator && !rule.group) { break; }
+            if (rule.prefix_operator && peek_token_is(TokenType::END)) {
+                return make_parser_unexpected(ParserError::PREFIX_MISSING_OPERAND,
+                                              current_token_);
+            }
+
+            TRY(nest());
+            pending.push_back({current_token_, precedence, rule.prefix_operator, nullptr, {}});
+            precedence = rule.group ? Precedence::LOWEST : Precedence::PREFIX;
+            advance();
+        }
+
+        const auto prefix = parse_rule(current_token_.type).prefix;
+        if (!prefix) {
+            return make_parser_unexpected(
+                DiagnosticMessage{"No prefix parse function for {}({}) found",
+                                  magic_enum::enum_name(current_token_.type),
+                                  current_token_.slice},
+                ParserError::MISSING_PREFIX_PARSER,
+                current_token_);
+        }
+        auto operand = TRY(prefix(*this));
+
+        // Semicolons and other non-binding tokens sit at LOWEST, so they always end the operand
+        while (true) {
+            const auto& rule = parse_rule(peek_token_.type);
+            if (rule.infix && precedence < rule.precedence) {
+                advance();
+                if (!rule.infix_operator) {
+                    operand = TRY(rule.infix(*this, std::move(operand)));
+                    continue;
+                }
+
+                if (peek_token_is(TokenType::END)) {
+                    return make_parser_unexpected(ParserError::INFIX_MISSING_RHS, current_token_);
+                }
+                TRY(nest());
+                pending.push_back(
+                    {current_token_, precedence, nullptr, rule.infix_operator, std::move(operand)});
+                precedence = rule.precedence;
+                advance();
+                break;
+            }
+
+            // The operand is complete, so it finishes the innermost pending operator
+            if (pending.empty()) { return operand; }
+            auto top = std::move(pending.back());
+            pending.pop_back();
+            depth_ -= 1;
+
+            if (top.prefix) {
+                operand = top.prefix(*this, top.token, std::move(operand));
+            } else if (top.infix) {
+                operand = top.infix(*this, std::move(top.lhs), top.token.type, std::move(operand));
+            } else {
+                TRY(expect_peek(TokenType::RPAREN));
+            }
+            precedence = top.precedence;
+        }
+    }
+}
+
+auto Parser::nest() -> Expected<std::monostate, ParserDiagnostic> {
+    if (depth_ >= options_.max_nesting_depth) {
+        return make_parser_unexpected(ParserError::NESTING_LIMIT_EXCEEDED, current_token_);
+    }
+    depth_ += 1;
+    return {};
 }
 
 auto Parser::tt_mismatch_error(TokenType expected, const Token& actual) -> ParserDiagnostic {
-    return ParserDiagnostic{fmt::format("Expected token {}, found {}",
-                                        magic_enum::enum_name(expected),
-                                        magic_enum::enum_name(actual.type)),
+    return ParserDiagnostic{DiagnosticMessage{"Expected token {}, found {}",
+                                              magic_enum::enum_name(expected),
+                                              magic_enum::enum_name(actual.type)},
                             ParserError::UNEXPECTED_TOKEN,
                             actual};
 }
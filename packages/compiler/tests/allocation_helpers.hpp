@@ -0,0 +1,10 @@
+#pragma once
+
+#include "types.hpp"
+
+// Exported by the test runner's Instrumentor, which counts every operator new and delete. The
+// counters are shared by every thread, so only read them around serial work.
+extern "C" {
+auto allocation_count() -> conch::u64;
+auto live_allocation_count() -> conch::u64;
+}
@@ -9,7 +9,7 @@
 
 namespace conch::tests {
 
-using Items = std::vector<Box<ast::Expression>>;
+using Items = ArenaVector<Box<ast::Expression>>;
 
 namespace helpers {
 
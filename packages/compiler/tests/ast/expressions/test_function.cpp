@@ -5,10 +5,11 @@
 #include "ast/expressions/function.hpp"
 #include "ast/expressions/type.hpp"
 #include "ast/statements/block.hpp"
+#include "ast/statements/declaration.hpp"
 
 namespace conch::tests {
 
-using Parameters = std::vector<ast::FunctionParameter>;
+using Parameters = ArenaVector<ast::FunctionParameter>;
 
 namespace helpers {
 
@@ -166,4 +167,87 @@ TEST_CASE("Non-terminated parameter list") {
     helpers::test_fail("fn(a: A, : int;", ParserDiagnostic{ParserError::ILLEGAL_IDENTIFIER, 1, 10});
 }
 
+constexpr ParserOptions LAZY{.lazy_function_bodies = true};
+
+static auto declared_function(const ast::Node& node) -> const ast::FunctionExpression& {
+    const auto& decl = helpers::try_into<ast::DeclStatement>(node);
+    REQUIRE(decl.has_value());
+    return helpers::try_into<ast::FunctionExpression>(decl.get_value());
+}
+
+TEST_CASE("Lazily parsed function bodies") {
+    constexpr std::string_view input{R"(
+        const f := fn(x: int): int { const g := fn(): int { return x; }; return g() + 1; };
+        const h := fn(): void;
+        f(2);
+    )"};
+
+    Parser eager{input};
+    auto [expected, expected_errors] = eager.consume();
+    helpers::check_errors<ParserDiagnostic>(expected_errors);
+
+    // The tree outlives its parser, so skipped bodies must keep their source alive
+    auto [actual, errors] = [&] {
+        Parser lazy{input, LAZY};
+        return lazy.consume();
+    }();
+    helpers::check_errors<ParserDiagnostic>(errors);
+    REQUIRE(actual.size() == expected.size());
+
+    const auto& f = declared_function(*actual[0]);
+    REQUIRE(f.is_body_deferred());
+    REQUIRE(f.has_body());
+    REQUIRE(f.load_body());
+    REQUIRE(f.get_body().size() == 2);
+    REQUIRE_FALSE(f.is_body_deferred());
+
+    // Bodies parsed on demand skip their own nested functions
+    const auto& g = declared_function(**f.get_body().begin());
+    REQUIRE(g.is_body_deferred());
+    REQUIRE(g.load_body());
+    REQUIRE_FALSE(g.is_body_deferred());
+
+    const auto& h = declared_function(*actual[1]);
+    REQUIRE_FALSE(h.is_body_deferred());
+    REQUIRE_FALSE(h.has_body());
+
+    helpers::require_same_parse(actual, expected);
+}
+
+TEST_CASE("Lazily parsed function body errors") {
+    constexpr std::string_view input{"const f := fn(): int { a b; }; c;"};
+    Parser                     eager{input};
+    auto [_, expected_errors] = eager.consume();
+    REQUIRE_FALSE(expected_errors.empty());
+
+    // Errors inside of a skipped body only surface once it is read
+    Parser lazy{input, LAZY};
+    auto [ast, errors] = lazy.consume();
+    helpers::check_errors<ParserDiagnostic>(errors);
+    REQUIRE(ast.size() == 2);
+
+    const auto& f      = declared_function(*ast[0]);
+    const auto  loaded = f.load_body();
+    REQUIRE_FALSE(loaded);
+    REQUIRE(loaded.error() == expected_errors.front());
+
+    // A body that fails to parse stays deferred and fails the same way every time it is loaded
+    REQUIRE(f.is_body_deferred());
+    const auto retried = f.load_body();
+    REQUIRE_FALSE(retried);
+    REQUIRE(retried.error() == loaded.error());
+
+    // Comparing never loads a body, it only matches bodies skipped over the same tokens
+    Parser again{input, LAZY};
+    auto [same, _] = again.consume();
+    REQUIRE(*same[0] == *ast[0]);
+    REQUIRE(declared_function(*same[0]).is_body_deferred());
+
+    // Unbalanced braces cannot be skipped, so they are parsed and reported right away
+    Parser unbalanced{"const f := fn(): int { a;", LAZY};
+    auto [unbalanced_ast, unbalanced_errors] = unbalanced.consume();
+    REQUIRE(unbalanced_ast.empty());
+    REQUIRE(unbalanced_errors.size() == 1);
+}
+
 } // namespace conch::tests
@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <span>
+#include <sstream>
+#include <string>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -11,6 +14,9 @@
 #include "ast/expressions/primitive.hpp"
 #include "ast/expressions/scope_resolve.hpp"
 
+#include "ast/dumper.hpp"
+#include "ast/flat.hpp"
+
 #include "lexer/operators.hpp"
 
 namespace conch::tests {
@@ -103,6 +109,19 @@ TEST_CASE("Miscellaneous infixes") {
     }
 }
 
+TEST_CASE("Comments inside expressions") {
+    helpers::test_binary_expr(
+        "a // lhs\n + // op\n b // rhs\n;",
+        helpers::ident_from("a"),
+        TokenType::PLUS,
+        helpers::ident_from("b"));
+    helpers::test_binary_expr(
+        "a// a\n*//\n//\nb; // trailing",
+        helpers::ident_from("a"),
+        TokenType::STAR,
+        helpers::ident_from("b"));
+}
+
 const Token a{TokenType::IDENT, "a"};
 const Token b{TokenType::IDENT, "b"};
 const Token c{TokenType::IDENT, "c"};
@@ -248,7 +267,7 @@ TEST_CASE("Call precedence") {
         TokenType::BOOLEAN_AND,
         ast::BinaryExpression{b,
                               make_box<ast::CallExpression>(
-                                  b, helpers::make_ident(b), std::vector<ast::CallArgument>{}),
+                                  b, helpers::make_ident(b), ArenaVector<ast::CallArgument>{}),
                               TokenType::NEQ,
                               helpers::make_ident(c)});
 }
@@ -330,4 +349,99 @@ TEST_CASE("Non-terminated infix") {
     helpers::test_fail("a and", ParserDiagnostic{ParserError::INFIX_MISSING_RHS, 1, 3});
 }
 
+TEST_CASE("Flattened binary chains") {
+    const ParserOptions flatten{.flatten_binary_chains = true};
+    const auto          expression = [](const ast::AST& ast) -> const ast::Expression& {
+        return helpers::into_expression_statement(*ast[0]).get_expression();
+    };
+
+    SECTION("Runs of one operator") {
+        Parser flat_parser{"a + b + c + d;", flatten};
+        auto [ast, errors] = flat_parser.consume();
+        helpers::check_errors<ParserDiagnostic>(errors);
+
+        const auto& chain = helpers::try_into<ast::BinaryChainExpression>(expression(ast));
+        REQUIRE(chain.get_op() == TokenType::PLUS);
+        REQUIRE(chain.get_operands().size() == 4);
+        REQUIRE(chain.get_token().slice == "a");
+
+        // The adapter matches what the parser builds without flattening
+        Parser nested_parser{"a + b + c + d;"};
+        auto [nested, _] = nested_parser.consume();
+        const auto spine = chain.as_binaries();
+        REQUIRE(spine.size() == 3);
+        REQUIRE(spine.matches(expression(nested)));
+
+        // Links borrow the chain's operands, and only the innermost one has a left operand
+        const auto operands = chain.get_operands();
+        REQUIRE(&*spine[0].lhs == operands[0].get());
+        REQUIRE(&spine[0].rhs == operands[1].get());
+        REQUIRE_FALSE(spine[2].lhs);
+        REQUIRE(&spine[2].rhs == operands[3].get());
+
+        Parser other_parser{"a + b + d + c;"};
+        auto [other, other_errors] = other_parser.consume();
+        REQUIRE_FALSE(spine.matches(expression(other)));
+    }
+
+    SECTION("Mixed operators and short runs stay binary") {
+        for (const auto input : {"a + b;", "a + b - c;", "a - (b - c);", "a * b + c * d;"}) {
+            Parser flat_parser{input, flatten};
+            auto [flattened, errors] = flat_parser.consume();
+            helpers::check_errors<ParserDiagnostic>(errors);
+
+            Parser nested_parser{input};
+            auto [nested, _] = nested_parser.consume();
+            REQUIRE(*flattened[0] == *nested[0]);
+        }
+    }
+
+    SECTION("Grouped operands") {
+        Parser flat_parser{"(a or b) or (c or d or e) or f;", flatten};
+        auto [ast, errors] = flat_parser.consume();
+        helpers::check_errors<ParserDiagnostic>(errors);
+
+        // Left associativity makes the leading group part of the run, unlike the one after it
+        const auto& chain    = helpers::try_into<ast::BinaryChainExpression>(expression(ast));
+        const auto  operands = chain.get_operands();
+        REQUIRE(operands.size() == 4);
+        REQUIRE(operands[2]->is<ast::BinaryChainExpression>());
+        REQUIRE(operands[3]->get_token().slice == "f");
+    }
+
+    SECTION("Flat lowering sees nested binaries") {
+        constexpr std::string_view input{"x == 1 or x == 2 or x == 3 or x == 4; a + b + c;"};
+        Parser                     flat_parser{input, flatten};
+        auto [flattened, flat_errors] = flat_parser.consume_flat();
+        helpers::check_errors<ParserDiagnostic>(flat_errors);
+
+        Parser nested_parser{input};
+        auto [nested, nested_errors] = nested_parser.consume_flat();
+        REQUIRE(std::ranges::equal(flattened.kinds(), nested.kinds()));
+        REQUIRE(std::ranges::equal(flattened.main_tokens(), nested.main_tokens()));
+        REQUIRE(std::ranges::equal(flattened.extra(), nested.extra()));
+        for (ast::FlatAST::Index i = 0; i < nested.size(); ++i) {
+            REQUIRE(flattened.data(i) == nested.data(i));
+        }
+    }
+
+    SECTION("Long chains dump without deep recursion") {
+        std::string input{"a"};
+        for (usize i = 0; i < 100000; ++i) { input += " + a"; }
+        input += ";";
+
+        Parser flat_parser{input, flatten};
+        auto [ast, errors] = flat_parser.consume();
+        helpers::check_errors<ParserDiagnostic>(errors);
+        REQUIRE(helpers::try_into<ast::BinaryChainExpression>(expression(ast))
+                    .get_operands()
+                    .size() == 100001);
+
+        std::ostringstream oss;
+        ast::ASTDumper     dumper{oss};
+        ast[0]->accept(dumper);
+        REQUIRE(oss.view().starts_with("ExpressionStatement"));
+    }
+}
+
 } // namespace conch::tests
@@ -61,6 +61,37 @@ TEST_CASE("Multi-line string parsing") {
                                TokenType::MULTILINE_STRING,
                                "Hello, 'World'!\n");
     helpers::test_primitive<N>("\\\\\n;", "", TokenType::MULTILINE_STRING, "");
+
+    // A doubled line marker on a single line is stripped just like on any other line
+    helpers::test_primitive<N>(
+        "\\\\\\\\Doubled\n;", "\\\\Doubled", TokenType::MULTILINE_STRING, "Doubled");
+}
+
+TEST_CASE("String literal storage") {
+    const std::string_view input{"\"plain\"; \\\\single\n;\n"
+                                 "\\\\two\n\\\\lines\n;\n"
+                                 "\\\\two\n\\\\lines\n;"};
+
+    Parser p{input};
+    auto [ast, errors] = p.consume();
+    helpers::check_errors<ParserDiagnostic>(errors);
+    REQUIRE(ast.size() == 4);
+
+    const auto value = [&ast](usize i) {
+        const auto& stmt = helpers::into_expression_statement(*ast[i]);
+        return helpers::try_into<ast::StringExpression>(stmt.get_expression()).get_value();
+    };
+
+    // Literals that need no processing view the source directly
+    REQUIRE(value(0) == "plain");
+    REQUIRE(value(0).data() == input.data() + 1);
+    REQUIRE(value(1) == "single");
+    REQUIRE(input.find(value(1)) == static_cast<usize>(value(1).data() - input.data()));
+
+    // Materialized literals are interned once and shared
+    REQUIRE(value(2) == "two\nlines");
+    REQUIRE(value(2).data() == value(3).data());
+    REQUIRE(p.literals()->size() == 1);
 }
 
 TEST_CASE("Signed integer parsing") {
@@ -15,7 +15,7 @@ namespace helpers {
 
 template <typename... Ds>
     requires(std::same_as<Ds, ast::DeclStatement> && ...)
-auto make_decls(Ds&&... decls) -> std::vector<Box<ast::DeclStatement>> {
+auto make_decls(Ds&&... decls) -> ArenaVector<Box<ast::DeclStatement>> {
     return make_vector<Box<ast::DeclStatement>>(make_box<Ds>(std::forward<Ds>(decls))...);
 }
 
@@ -28,7 +28,7 @@ auto test_type_expr(std::string_view type_str, ast::ExplicitType&& expected) ->
 
 namespace mods = helpers::type_modifiers;
 
-using Parameters = std::vector<ast::FunctionParameter>;
+using Parameters = ArenaVector<ast::FunctionParameter>;
 
 TEST_CASE("Indent type") {
     helpers::test_type_expr("int", ast::ExplicitType{mods::BASE, helpers::make_ident("int")});
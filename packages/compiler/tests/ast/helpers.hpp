@@ -2,12 +2,12 @@
 
 #include <algorithm>
 #include <span>
-#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 
+#include "arena.hpp"
 #include "string.hpp"
 
 #include "ast/expressions/function.hpp"
@@ -15,6 +15,8 @@
 #include "ast/statements/block.hpp"
 #include "ast/statements/expression.hpp"
 
+#include "parser/parser.hpp"
+
 #include "lexer/keywords.hpp"
 
 namespace conch::tests::helpers {
@@ -54,6 +56,21 @@ auto test_fail(std::string_view failing, Ds&&... expected_diagnostics) -> void {
     REQUIRE(std::ranges::equal(errors, expected_arr));
 }
 
+// Requires two parses of the same input to produce equal top level nodes.
+inline auto require_same_parse(const ast::AST& actual, const ast::AST& expected) -> void {
+    REQUIRE(actual.size() == expected.size());
+    for (usize i = 0; i < actual.size(); ++i) { REQUIRE(*actual[i] == *expected[i]); }
+}
+
+// Requires two parses of the same input to produce equal trees and diagnostics in the same order.
+inline auto require_same_parse(const ast::AST&                   actual,
+                               const ast::AST&                   expected,
+                               std::span<const ParserDiagnostic> actual_errors,
+                               std::span<const ParserDiagnostic> expected_errors) -> void {
+    require_same_parse(actual, expected);
+    REQUIRE(std::ranges::equal(actual_errors, expected_errors));
+}
+
 constexpr auto trim_semicolons(std::string_view str) -> std::string_view {
     return string::trim_right(str, [](byte b) { return b == ';'; });
 }
@@ -89,8 +106,8 @@ template <ast::LeafNode N> auto test_expr_stmt(std::string_view input, N&& expec
     test_expr_stmt(input, expected.get_token(), std::move(expected));
 }
 
-template <typename T, typename... Ts> auto make_vector(Ts&&... es) -> std::vector<T> {
-    std::vector<T> list;
+template <typename T, typename... Ts> auto make_vector(Ts&&... es) -> ArenaVector<T> {
+    ArenaVector<T> list;
     list.reserve(sizeof...(es));
     (list.emplace_back(std::forward<Ts>(es)), ...);
     return list;
@@ -141,7 +158,7 @@ auto make_expr_block_stmt(Ns&&... nodes) -> Box<ast::BlockStatement> {
 
 template <typename... Ps>
     requires(std::same_as<Ps, ast::FunctionParameter> && ...)
-auto make_parameters(Ps&&... params) -> std::vector<ast::FunctionParameter> {
+auto make_parameters(Ps&&... params) -> ArenaVector<ast::FunctionParameter> {
     return make_vector<ast::FunctionParameter>(std::forward<Ps>(params)...);
 }
 
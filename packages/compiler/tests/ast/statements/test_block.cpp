@@ -27,6 +27,15 @@ TEST_CASE("Empty block") {
     helpers::test_stmt("{}", helpers::expr_block_stmt_from());
 }
 
+TEST_CASE("Comments inside blocks") {
+    helpers::test_stmt("{ // a\n a; // b\n // c\n b; };",
+                       helpers::expr_block_stmt_from(helpers::ident_from("a"),
+                                                     helpers::ident_from("b")));
+    helpers::test_stmt("{ // only a comment\n };", helpers::expr_block_stmt_from());
+    helpers::test_stmt("{ a // before the semicolon\n ; } // after the block",
+                       helpers::expr_block_stmt_from(helpers::ident_from("a")));
+}
+
 TEST_CASE("Non-terminated block") {
     helpers::test_fail(
         "{ ",
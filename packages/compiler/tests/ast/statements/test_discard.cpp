@@ -15,7 +15,7 @@ TEST_CASE("Discard statements") {
         ast::DiscardStatement{
             start_token, make_box<ast::SignedIntegerExpression>(Token{TokenType::INT_10, "4"}, 4)});
 
-    std::vector<ast::Enumeration> enumerations;
+    ArenaVector<ast::Enumeration> enumerations;
     enumerations.emplace_back(ast::Enumeration{helpers::make_ident("RED"), nullopt});
     helpers::test_stmt(
         "_ = enum { RED };",
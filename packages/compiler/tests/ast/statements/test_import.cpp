@@ -23,7 +23,7 @@ TEST_CASE("User imports") {
                        ast::ImportStatement{Token{keywords::IMPORT},
                                             make_box<ast::StringExpression>(
                                                 Token{TokenType::STRING, R"("ast/node.conch")"},
-                                                std::string{"ast/node.conch"}),
+                                                std::string_view{"ast/node.conch"}),
                                             helpers::make_ident("node")});
 }
 
@@ -20,7 +20,7 @@ TEST_CASE("Expression returns") {
                                           make_box<ast::SignedIntegerExpression>(
                                               Token{TokenType::INT_10, "4"}, 4)});
 
-    std::vector<ast::Enumeration> enumerations;
+    ArenaVector<ast::Enumeration> enumerations;
     enumerations.emplace_back(ast::Enumeration{helpers::make_ident("RED"), nullopt});
     helpers::test_stmt("return enum { RED };",
                        ast::JumpStatement{Token{keywords::RETURN},
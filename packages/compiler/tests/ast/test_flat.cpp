@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "ast/helpers.hpp"
+
+#include "ast/ast.hpp"
+#include "ast/flat.hpp"
+
+namespace conch::tests {
+
+namespace flat = ast::flat;
+
+TEST_CASE("Flat lowering resolves every start token") {
+    constexpr std::string_view input{R"(
+        [_]*N{a, b, c, "54" };
+        a or b[3uz] == !c;
+        import "ast/node.conch" as node;
+        while (true) : (i += 1) {a;} else return b;
+        var f_ptr: *fn(&a, b: *mut B): &[0x2uz][N]*E;
+        packed struct { var a: Foo = bar; const b := fn(*mut this, a: A): C { c; }; };
+        match (a) { b => |c| d; e => |_| f; g => h; } else d;
+        for (arr, l) |i, _| { a; } else return b;
+        enum : ulong {A = 1ul, B = T, C, };
+        a(&mut r, t, *[N]int);
+        union { a: int, b: &mut T, };
+        do { a; } while (true);
+        using T = int;
+        defer 3;
+    )"};
+
+    Parser p{input};
+    auto [flat_ast, errors] = p.consume_flat();
+    helpers::check_errors<ParserDiagnostic>(errors);
+    REQUIRE(flat_ast.roots().size() == 14);
+
+    for (ast::FlatAST::Index i = 0; i < flat_ast.size(); ++i) {
+        REQUIRE(flat_ast.main_token(i) != flat::NONE);
+    }
+
+    // Start tokens resolve to the same tokens the pointer tree holds
+    auto [tree, _] = p.consume();
+    REQUIRE(tree.size() == flat_ast.roots().size());
+    for (usize i = 0; i < tree.size(); ++i) {
+        const auto flat_token = flat_ast.token(flat_ast.roots()[i]);
+        REQUIRE(flat_token == tree[i]->get_token());
+    }
+
+    // Nodes are laid out in pre-order, so each root precedes everything it contains
+    REQUIRE(flat_ast.roots().front() == 0);
+    REQUIRE(std::ranges::is_sorted(flat_ast.roots()));
+    REQUIRE(flat_ast.kind(flat_ast.roots()[2]) == ast::NodeKind::IMPORT_STATEMENT);
+    REQUIRE(flat_ast.kind(flat_ast.roots()[4]) == ast::NodeKind::DECL_STATEMENT);
+}
+
+TEST_CASE("Flat views mirror the pointer getters") {
+    Parser p{"const f := fn(x: int, y: *mut [4uz]int): int { return x * 2 + y[0]; };"};
+    auto [flat_ast, errors] = p.consume_flat();
+    helpers::check_errors<ParserDiagnostic>(errors);
+    REQUIRE(flat_ast.roots().size() == 1);
+
+    const auto decl = flat_ast.view<flat::DeclStatement>(flat_ast.roots()[0]);
+    REQUIRE(decl.get_modifiers() == ast::DeclModifiers::CONSTANT);
+    REQUIRE(flat_ast.view<flat::IdentifierExpression>(decl.get_ident()).get_name() == "f");
+    REQUIRE_FALSE(flat_ast.view<flat::TypeExpression>(decl.get_type()).has_explicit_type());
+    REQUIRE(decl.has_value());
+
+    const auto fn = flat_ast.view<flat::FunctionExpression>(decl.get_value());
+    REQUIRE_FALSE(fn.has_self());
+    REQUIRE(fn.get_token().type == TokenType::FUNCTION);
+    REQUIRE(fn.get_return_type().is_ident_type());
+
+    const auto params = fn.get_parameters();
+    REQUIRE(params.size() == 2);
+    REQUIRE(flat_ast.view<flat::IdentifierExpression>(params[0].get_ident()).get_name() == "x");
+    REQUIRE(params[0].get_type().get_modifier().is_value());
+
+    const auto y_type = params[1].get_type();
+    REQUIRE(y_type.get_modifier().is_mutable_ptr());
+    REQUIRE(y_type.is_array_type());
+    REQUIRE(y_type.has_dimension());
+    REQUIRE(flat_ast.view<flat::PrimitiveExpression<ast::USizeIntegerExpression>>(
+                        y_type.get_dimension())
+                .get_value() == 4);
+    REQUIRE(y_type.get_inner_type().is_ident_type());
+
+    REQUIRE(fn.has_body());
+    const auto body = flat_ast.view<flat::BlockStatement>(fn.get_body());
+    REQUIRE(body.get_statements().size() == 1);
+
+    const auto ret = flat_ast.view<flat::JumpStatement>(body.get_statements()[0]);
+    REQUIRE(ret.get_token().type == TokenType::RETURN);
+    REQUIRE(ret.has_expression());
+
+    // Operators keep their precedence in the tree shape: (x * 2) + y[0]
+    const auto sum = flat_ast.view<flat::InfixExpression<ast::BinaryExpression>>(
+        ret.get_expression());
+    REQUIRE(sum.get_op() == TokenType::PLUS);
+
+    const auto product = flat_ast.view<flat::InfixExpression<ast::BinaryExpression>>(sum.get_lhs());
+    REQUIRE(product.get_op() == TokenType::STAR);
+    REQUIRE(flat_ast.view<flat::PrimitiveExpression<ast::SignedIntegerExpression>>(
+                        product.get_rhs())
+                .get_value() == 2);
+
+    const auto index = flat_ast.view<flat::IndexExpression>(sum.get_rhs());
+    REQUIRE(flat_ast.view<flat::IdentifierExpression>(index.get_array()).get_name() == "y");
+}
+
+TEST_CASE("Flat primitive payloads") {
+    Parser p{R"(-9l; 2.5; 1.5f; 'c'; false; "a\nb"; 18446744073709551615ul;)"};
+    auto [flat_ast, errors] = p.consume_flat();
+    helpers::check_errors<ParserDiagnostic>(errors);
+    REQUIRE(flat_ast.roots().size() == 7);
+
+    const auto inner = [&](usize root) {
+        return flat_ast.view<flat::WrapperStatement<ast::ExpressionStatement>>(
+                           flat_ast.roots()[root])
+            .get_inner();
+    };
+
+    const auto negated = flat_ast.view<flat::PrefixExpression<ast::UnaryExpression>>(inner(0));
+    REQUIRE(negated.get_op() == TokenType::MINUS);
+    REQUIRE(flat_ast.view<flat::PrimitiveExpression<ast::SignedLongIntegerExpression>>(
+                        negated.get_rhs())
+                .get_value() == 9);
+
+    REQUIRE(flat_ast.view<flat::PrimitiveExpression<ast::DoubleExpression>>(inner(1))
+                .get_value() == 2.5);
+    REQUIRE(flat_ast.view<flat::PrimitiveExpression<ast::FloatExpression>>(inner(2))
+                .get_value() == 1.5f);
+    REQUIRE(flat_ast.view<flat::PrimitiveExpression<ast::ByteExpression>>(inner(3))
+                .get_value() == 'c');
+    REQUIRE_FALSE(flat_ast.view<flat::PrimitiveExpression<ast::BoolExpression>>(inner(4))
+                      .get_value());
+    REQUIRE(flat_ast.view<flat::PrimitiveExpression<ast::StringExpression>>(inner(5))
+                .get_value() == R"(a\nb)");
+    REQUIRE(flat_ast.view<flat::PrimitiveExpression<ast::UnsignedLongIntegerExpression>>(inner(6))
+                .get_value() == 18446744073709551615ul);
+}
+
+TEST_CASE("Flat lowering of long left associative spines") {
+    // Parsed without recursion, so lowering must not recurse along the spine either
+    constexpr usize TERMS = 200000;
+    std::string     input{"a"};
+    for (usize i = 1; i < TERMS; ++i) { input += " + a"; }
+    input += ";";
+
+    Parser p{input};
+    auto [flat_ast, errors] = p.consume_flat();
+    helpers::check_errors<ParserDiagnostic>(errors);
+    REQUIRE(flat_ast.roots().size() == 1);
+    REQUIRE(flat_ast.size() == 2 * TERMS);
+
+    // The outermost operator comes first, the innermost operand right after the spine
+    const auto sum = flat_ast.view<flat::InfixExpression<ast::BinaryExpression>>(
+        flat_ast.view<flat::WrapperStatement<ast::ExpressionStatement>>(flat_ast.roots()[0])
+            .get_inner());
+    REQUIRE(sum.get_op() == TokenType::PLUS);
+    REQUIRE(flat_ast.kind(TERMS) == ast::NodeKind::IDENTIFIER_EXPRESSION);
+    REQUIRE(flat_ast.token(TERMS).slice == "a");
+}
+
+TEST_CASE("Flat lowering of long call and index chains") {
+    // Postfix chains are parsed in a loop too, and lowering takes them from a stack
+    constexpr usize LINKS = 200000;
+    for (const std::string_view link : {"()", "[0]"}) {
+        std::string input{"a"};
+        for (usize i = 0; i < LINKS; ++i) { input += link; }
+        input += ";";
+
+        Parser p{input};
+        auto [flat_ast, errors] = p.consume_flat();
+        helpers::check_errors<ParserDiagnostic>(errors);
+        REQUIRE(flat_ast.roots().size() == 1);
+        REQUIRE(flat_ast.kind(LINKS + 1) == ast::NodeKind::IDENTIFIER_EXPRESSION);
+    }
+}
+
+TEST_CASE("Flat lowering reports lazy body failures") {
+    constexpr std::string_view input{"const f := fn(): int { a b; };"};
+    Parser                     eager{input};
+    auto [_, expected] = eager.consume_flat();
+    REQUIRE(expected.size() == 1);
+
+    // The body is only read while lowering, after the pointer tree's diagnostics were collected
+    Parser lazy{input, {.lazy_function_bodies = true}};
+    auto [flat_ast, errors] = lazy.consume_flat();
+    REQUIRE(flat_ast.roots().size() == 1);
+    REQUIRE(errors == expected);
+}
+
+} // namespace conch::tests
@@ -0,0 +1,121 @@
+#include <string>
+#include <string_view>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "lexer/lexer.hpp"
+#include "lexer/operators.hpp"
+
+#include "types.hpp"
+
+namespace conch::tests {
+
+static auto operator_dense_source() -> std::string {
+    std::string source;
+    for (usize i = 0; i < 2000; ++i) {
+        source += "a <<= b >> c..=d; x += &mut y->z => w != v :: u and t or s;\n"
+                  "p.q = *mut r ^ ~s | t & u <= v >= w == x %= y /= z;\n";
+    }
+    return source;
+}
+
+// A large machine-generated table, the kind of input worth lexing on every core.
+static auto generated_table_source() -> std::string {
+    std::string source;
+    for (usize i = 0; i < 200000; ++i) {
+        source += "const ENTRY_" + std::to_string(i) + " := .{ \"name\", 0x" + std::to_string(i) +
+                  ", 'c', 3.25 }; // row\n";
+    }
+    return source;
+}
+
+// The previous matcher, which binary searched the operator table once per prefix length.
+static auto match_operator_by_search(std::string_view input) noexcept -> usize {
+    usize max_len = 0;
+    for (usize len = 1; len <= MAX_OPERATOR_LEN && len <= input.size(); ++len) {
+        const auto candidate = input.substr(0, len);
+        const auto it = std::ranges::lower_bound(ALL_OPERATORS, candidate, {}, &Operator::first);
+        if (it != ALL_OPERATORS.end() && it->first == candidate) { max_len = len; }
+    }
+    return max_len;
+}
+
+TEST_CASE("Operator matching throughput", "[.][benchmark]") {
+    const auto source = operator_dense_source();
+
+    BENCHMARK("Binary search per prefix length") {
+        usize matched = 0;
+        for (usize i = 0; i < source.size(); ++i) {
+            matched += match_operator_by_search(std::string_view{source}.substr(i));
+        }
+        return matched;
+    };
+
+    BENCHMARK("Operator DFA") {
+        usize matched = 0;
+        for (usize i = 0; i < source.size(); ++i) {
+            const auto op = match_operator(std::string_view{source}.substr(i));
+            matched += op ? op->first.size() : 0;
+        }
+        return matched;
+    };
+
+    BENCHMARK("Lexing operator dense code") {
+        Lexer l{source};
+        return l.consume().size();
+    };
+}
+
+TEST_CASE("Parallel lexing throughput", "[.][benchmark]") {
+    const auto source = generated_table_source();
+
+    BENCHMARK("Serial consume") {
+        Lexer l{source};
+        return l.consume().size();
+    };
+
+    BENCHMARK("Parallel consume") {
+        Lexer l{source};
+        return l.consume_parallel().size();
+    };
+}
+
+// Trivia retention is compiled out of the parser's lexer, so with the feature off it should lex
+// as fast as it did before trivia existed. The first case only uses what the lexer had back then,
+// so running it on an older tree gives the baseline to compare against. The trivia lexer pays
+// for its side table on the same input.
+TEST_CASE("Trivia retention overhead", "[.][benchmark]") {
+    const auto source = generated_table_source();
+
+    BENCHMARK("Parser lexer, trivia off") {
+        ParserLexer l{source};
+        return l.consume().size();
+    };
+
+    BENCHMARK("Trivia lexer, trivia on") {
+        TriviaLexer l{source};
+        return l.consume().size() + l.trivia().size();
+    };
+}
+
+TEST_CASE("Incremental relexing throughput", "[.][benchmark]") {
+    const auto     source = generated_table_source();
+    const TextEdit edit{source.size() / 2, 1, "x"};
+    const auto     edited = edit.apply(source);
+
+    Lexer      l{source};
+    const auto previous = l.consume();
+
+    BENCHMARK("Full consume after an edit") {
+        l.reset(edited);
+        return l.consume().size();
+    };
+
+    BENCHMARK("Relex after an edit") {
+        l.reset(edited);
+        return l.relex(previous, edit).size();
+    };
+}
+
+} // namespace conch::tests
@@ -1,11 +1,17 @@
+#include <algorithm>
+#include <iterator>
 #include <ranges>
+#include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
+#include "lexer/char_class.hpp"
 #include "lexer/keywords.hpp"
 #include "lexer/lexer.hpp"
+#include "lexer/operators.hpp"
 #include "lexer/token.hpp"
 
 namespace conch::tests {
@@ -13,17 +19,51 @@ namespace conch::tests {
 using ExpectedLexeme = std::pair<TokenType, std::string_view>;
 
 TEST_CASE("Illegal characters") {
-    Lexer      l{"月😭🎶"};
-    const auto tokens = l.consume();
+    // Non-identifier code points are illegal as a whole, malformed bytes one at a time
+    Lexer l{"😭🎶\xff\xc3$"};
 
-    for (size_t i = 0; i < tokens.size(); ++i) {
-        const auto& token = tokens[i];
-        if (i == tokens.size() - 1) {
-            REQUIRE(token.type == TokenType::END);
-            break;
-        }
-        REQUIRE(token.type == TokenType::ILLEGAL);
+    const auto expecteds = std::to_array<ExpectedLexeme>({
+        {TokenType::ILLEGAL, "😭"},
+        {TokenType::ILLEGAL, "🎶"},
+        {TokenType::ILLEGAL, "\xff"},
+        {TokenType::ILLEGAL, "\xc3"},
+        {TokenType::ILLEGAL, "$"},
+        {TokenType::END, ""},
+    });
+
+    for (const auto& [expected_tok, expected_slice] : expecteds) {
+        const auto token = l.advance();
+        REQUIRE(expected_tok == token.type);
+        REQUIRE(expected_slice == token.slice);
+    }
+}
+
+TEST_CASE("Unicode identifiers") {
+    Lexer l{"月 := naïve_2 + café·x;\nΔt ∑ x月"};
+
+    const auto expecteds = std::to_array<ExpectedLexeme>({
+        {TokenType::IDENT, "月"},
+        {TokenType::WALRUS, ":="},
+        {TokenType::IDENT, "naïve_2"},
+        {TokenType::PLUS, "+"},
+        {TokenType::IDENT, "café·x"},
+        {TokenType::SEMICOLON, ";"},
+        {TokenType::IDENT, "Δt"},
+        {TokenType::ILLEGAL, "∑"},
+        {TokenType::IDENT, "x月"},
+        {TokenType::END, ""},
+    });
+
+    for (const auto& [expected_tok, expected_slice] : expecteds) {
+        const auto token = l.advance();
+        REQUIRE(expected_tok == token.type);
+        REQUIRE(expected_slice == token.slice);
     }
+
+    // Columns count bytes, so a three byte code point spans three columns
+    l.reset("月 x");
+    REQUIRE(l.advance().column == 1);
+    REQUIRE(l.advance().column == 5);
 }
 
 TEST_CASE("Lexer over-consumption") {
@@ -303,6 +343,326 @@ TEST_CASE("Comments") {
     }
 }
 
+TEST_CASE("Lexer policies") {
+    const std::string_view input{"// header\nvar x := 0x2A; // trailing\n  // indented\n"
+                                 "x = x / 2;//\n"};
+
+    // The parser's lexer skips comments but keeps everything else, locations included
+    Lexer       full{input};
+    ParserLexer parser{input};
+    for (const auto& token : full) {
+        if (token.type == TokenType::COMMENT) { continue; }
+
+        const auto other = parser.advance();
+        REQUIRE(other.type == token.type);
+        REQUIRE(other.slice == token.slice);
+        REQUIRE(other.line == token.line);
+        REQUIRE(other.column == token.column);
+    }
+    REQUIRE(parser.advance().type == TokenType::END);
+    REQUIRE(parser.integers().size() == 2);
+
+    // Highlighting sees the same kinds and offsets without decoding any literals
+    HighlightLexer highlight{input};
+    const auto     tokens   = highlight.consume();
+    const auto     expected = Lexer{input}.consume();
+    REQUIRE(std::ranges::equal(tokens.types(), expected.types()));
+    REQUIRE(std::ranges::equal(tokens.offsets(), expected.offsets()));
+    REQUIRE(highlight.integers().size() == 0);
+}
+
+TEST_CASE("Trivia retention") {
+    const std::string_view input{"  // header\n\nvar x := \\\\ multi\n\\\\ line\n;\t// tail\n  "};
+    TriviaLexer            l{input};
+    const auto             tokens = l.consume();
+    const auto&            trivia = l.trivia();
+    REQUIRE(trivia.size() == tokens.size());
+
+    // Comments stay out of the token stream, yet trivia and lexemes rebuild the source exactly
+    std::string rebuilt;
+    for (usize i = 0; i < tokens.size(); ++i) {
+        REQUIRE(tokens.type(i) != TokenType::COMMENT);
+        REQUIRE(trivia.lexeme(i).ends_with(tokens.slice(i)));
+        rebuilt += trivia.leading(i);
+        rebuilt += trivia.lexeme(i);
+    }
+    REQUIRE(rebuilt == input);
+    REQUIRE(trivia.lexeme(3) == "\\\\ multi\n\\\\ line");
+
+    const auto header = trivia.pieces(0);
+    REQUIRE(header.size() == 3);
+    REQUIRE(header[0].kind == TriviaKind::WHITESPACE);
+    REQUIRE(header[0].text == "  ");
+    REQUIRE(header[1].kind == TriviaKind::COMMENT);
+    REQUIRE(header[1].text == "// header");
+    REQUIRE(header[2].text == "\n\n");
+
+    const auto tail = trivia.pieces(tokens.size() - 1);
+    REQUIRE(tail.size() == 3);
+    REQUIRE(tail[1].kind == TriviaKind::COMMENT);
+    REQUIRE(tail[1].text == "// tail");
+    REQUIRE(trivia.pieces(1).size() == 1);
+
+    // Lexers without the feature neither expose it nor spend space on it, though MSVC's ABI ignores
+    // the attribute that lets the placeholder take no room
+    STATIC_REQUIRE_FALSE(requires(const ParserLexer& lexer) { lexer.trivia(); });
+#if !defined(_MSC_VER)
+    STATIC_REQUIRE(sizeof(ParserLexer) + sizeof(TriviaTable) == sizeof(TriviaLexer));
+#endif
+}
+
+TEST_CASE("Character classes") {
+    REQUIRE(char_is('a', CharClass::IDENT_START));
+    REQUIRE_FALSE(char_is('Z', CharClass::HEX_DIGIT));
+    REQUIRE(char_is('F', CharClass::HEX_DIGIT));
+    REQUIRE(char_is('_', CharClass::IDENT_CONTINUE));
+    REQUIRE_FALSE(char_is('_', CharClass::IDENT_START));
+    REQUIRE(char_is('7', CharClass::DIGIT));
+    REQUIRE(char_is('\v', CharClass::WHITESPACE));
+    REQUIRE(char_is(':', CharClass::OPERATOR_START));
+    REQUIRE(char_is(':', CharClass::MISC));
+    REQUIRE(char_info(':').misc == TokenType::COLON);
+    REQUIRE(char_info('\0').action == LexAction::END);
+
+    // Bytes outside of ASCII never classify on their own, regardless of the process locale
+    for (usize c = 0x80; c < 0x100; ++c) {
+        const auto& info = char_info(static_cast<byte>(c));
+        REQUIRE(info.classes == CharClass::NONE);
+        REQUIRE(info.action == LexAction::UNICODE);
+    }
+}
+
+TEST_CASE("Operator maximal munch") {
+    // Every string over the operator alphabet must match the longest operator prefixing it
+    std::string alphabet;
+    for (const auto& [op, _] : ALL_OPERATORS) {
+        for (const auto c : op) {
+            if (!alphabet.contains(c)) { alphabet += c; }
+        }
+    }
+    alphabet += 'x';
+
+    const auto longest_prefix = [](std::string_view input) -> Optional<Operator> {
+        Optional<Operator> longest;
+        for (const auto& op : ALL_OPERATORS) {
+            const auto longer = !longest || op.first.size() > longest->first.size();
+            if (input.starts_with(op.first) && longer) {
+                longest = Operator{input.substr(0, op.first.size()), op.second};
+            }
+        }
+        return longest;
+    };
+
+    const auto base         = alphabet.size();
+    usize      combinations = 1;
+    for (usize i = 0; i < MAX_OPERATOR_LEN; ++i) { combinations *= base; }
+
+    std::string input(MAX_OPERATOR_LEN, ' ');
+    for (usize combination = 0; combination < combinations; ++combination) {
+        for (usize i = 0, rest = combination; i < input.size(); ++i, rest /= base) {
+            input[i] = alphabet[rest % base];
+        }
+
+        const auto expected = longest_prefix(input);
+        const auto actual   = match_operator(input);
+        REQUIRE(expected.has_value() == actual.has_value());
+        if (expected) { REQUIRE(*expected == *actual); }
+    }
+}
+
+TEST_CASE("Long whitespace and comment runs") {
+    std::string input;
+    for (usize i = 0; i < 70; ++i) {
+        input.append(i, i % 3 == 0 ? ' ' : '\t');
+        input += "x" + std::to_string(i);
+        input.append(i % 5, i % 2 == 0 ? '\n' : ' ');
+        if (i % 4 == 0) { input += "// " + std::string(i, '=') + "\r\n"; }
+    }
+    input += "  \n\n   ";
+
+    // Every token must land exactly where a byte-by-byte walk would place it
+    const auto expected_location = [&input](usize offset) -> std::pair<usize, usize> {
+        const auto before    = std::string_view{input}.substr(0, offset);
+        const auto last_line = before.rfind('\n');
+        const auto line      = 1 + static_cast<usize>(std::ranges::count(before, '\n'));
+        return {line, last_line == std::string_view::npos ? offset + 1 : offset - last_line};
+    };
+
+    Lexer              l{input};
+    std::vector<Token> tokens;
+    do { tokens.emplace_back(l.advance()); } while (tokens.back().type != TokenType::END);
+    REQUIRE(tokens.size() == 70 + 18 + 1);
+
+    for (const auto& token : tokens) {
+        const auto offset =
+            token.type == TokenType::END ? input.size()
+                                         : static_cast<usize>(token.slice.data() - input.data());
+        const auto [line, column] = expected_location(offset);
+        REQUIRE(token.line == line);
+        REQUIRE(token.column == column);
+    }
+}
+
+TEST_CASE("Token buffer") {
+    STATIC_REQUIRE(sizeof(CompactToken) * 3 <= sizeof(Token));
+    STATIC_REQUIRE(std::random_access_iterator<TokenBuffer::Iterator>);
+
+    const std::string_view input{"const five := 5; //\n"
+                                 "var ten_10 := 10;\r\n\n"
+                                 "\t// BOL\n"
+                                 "var s := \\\\multi\n"
+                                 "\\\\line\n"
+                                 "; 'a' \"str\" @sizeOf(five) \\\\\n"
+                                 "月 work->more;"};
+
+    Lexer              l{input};
+    std::vector<Token> expected;
+    do { expected.emplace_back(l.advance()); } while (expected.back().type != TokenType::END);
+
+    l.reset(input);
+    const auto tokens = l.consume();
+    REQUIRE(tokens.size() == expected.size());
+    REQUIRE(tokens.back().type == TokenType::END);
+
+    for (usize i = 0; i < tokens.size(); ++i) {
+        REQUIRE(tokens.type(i) == expected[i].type);
+        REQUIRE(tokens.slice(i) == expected[i].slice);
+        REQUIRE(tokens[i] == expected[i]);
+    }
+
+    // The iterator adapter materializes the same tokens
+    usize i = 0;
+    for (const auto& token : tokens) { REQUIRE(token == expected[i++]); }
+    REQUIRE(std::ranges::equal(tokens, expected));
+    REQUIRE(std::ranges::count(tokens.types(), TokenType::VAR) == 2);
+}
+
+TEST_CASE("Parallel lexing") {
+    // Strings spanning lines, comments and multiline strings all make newline chunks misleading
+    std::string input;
+    for (usize i = 0; i < 40; ++i) {
+        input += "const a := \"first\n"
+                 "var b := 'c'; // not code\n"
+                 "\";\n"
+                 "var s := \\\\ \"open\n"
+                 "    \\\\ 'x' var t := 2;\n"
+                 "// \" dangling quote\n"
+                 "b += 0x1F >> 'q';\r\n\n";
+    }
+
+    Lexer      l{input};
+    const auto expected = l.consume();
+
+    for (const usize min_chunk_size : {1, 7, 64, 1000}) {
+        for (const usize threads : {2, 3, 8}) {
+            l.reset(input);
+            const auto tokens = l.consume_parallel({threads, min_chunk_size});
+            REQUIRE(std::ranges::equal(tokens.types(), expected.types()));
+            REQUIRE(std::ranges::equal(tokens.offsets(), expected.offsets()));
+            REQUIRE(std::ranges::equal(tokens.lengths(), expected.lengths()));
+            REQUIRE(l.advance().type == TokenType::END);
+        }
+    }
+
+    // Small inputs and embedded terminators behave exactly like the serial lexer
+    constexpr char         TERMINATED[] = "var a := 1;\nvar b\0 := 2;\nvar c := 3;\n";
+    const std::string_view terminated{TERMINATED, sizeof(TERMINATED) - 1};
+    l.reset(terminated);
+    const auto serial = l.consume();
+    l.reset(terminated);
+    const auto parallel = l.consume_parallel({4, 1});
+    REQUIRE(std::ranges::equal(parallel.types(), serial.types()));
+    REQUIRE(std::ranges::equal(parallel.offsets(), serial.offsets()));
+}
+
+TEST_CASE("Incremental relexing") {
+    const std::string source{"const a := \"str\n"
+                             "ing\"; // note\r\n"
+                             "var b := \\\\ one\r\n"
+                             "  \\\\ two\n"
+                             "b += 1.5e+3 ..= 'c';\n"
+                             "and_more or @sizeOf(a);"};
+
+    const auto require_fresh = [](std::string_view edited, const TokenBuffer& relexed) {
+        Lexer      fresh{edited};
+        const auto expected = fresh.consume();
+        REQUIRE(std::ranges::equal(relexed.types(), expected.types()));
+        REQUIRE(std::ranges::equal(relexed.offsets(), expected.offsets()));
+        REQUIRE(std::ranges::equal(relexed.lengths(), expected.lengths()));
+    };
+
+    Lexer      l{source};
+    const auto previous = l.consume();
+
+    // Every small edit at every position must agree with lexing the edited source from scratch
+    for (const std::string_view replacement : {"", "x", "\"", "'", "//", "\\\\", "\n", ".", "e"}) {
+        for (usize offset = 0; offset <= source.size(); ++offset) {
+            for (usize length = 0; length <= 3 && offset + length <= source.size(); ++length) {
+                const TextEdit edit{offset, length, replacement};
+                const auto     edited = edit.apply(source);
+                l.reset(edited);
+                require_fresh(edited, l.relex(previous, edit));
+            }
+        }
+    }
+
+    // Edits chain, each relexing against the stream of the last
+    std::string current{source};
+    auto        tokens = previous;
+    for (const auto& edit : {TextEdit{0, 5, "var"}, TextEdit{20, 0, "\"\n"}, TextEdit{3, 9, ""}}) {
+        current = edit.apply(current);
+        l.reset(current);
+        tokens = l.relex(tokens, edit);
+        require_fresh(current, tokens);
+        REQUIRE(l.advance().type == TokenType::END);
+    }
+}
+
+TEST_CASE("Decoded integer literals") {
+    const std::string_view input{"7 123456789 0x1F 0XdeadBEEFcafe1234ul 0b101 0o17 "
+                                 "18446744073709551615u 18446744073709551616 0x10000000000000000 "
+                                 "1.5 1e9 12345678.25 000000000042z"};
+
+    const auto expecteds = std::to_array<std::pair<u64, bool>>({
+        {7, false},
+        {123456789, false},
+        {0x1F, false},
+        {0xDEADBEEFCAFE1234, false},
+        {0b101, false},
+        {017, false},
+        {18446744073709551615u, false},
+        {0, true},
+        {0, true},
+        {42, false},
+    });
+
+    Lexer l{input};
+    usize i = 0;
+    for (const auto& token : l) {
+        const auto offset  = static_cast<usize>(token.slice.data() - input.data());
+        const auto literal = l.integers().find(offset);
+        if (token.type == TokenType::FLOAT || token.type == TokenType::DOUBLE) {
+            REQUIRE_FALSE(literal);
+            continue;
+        }
+
+        REQUIRE(literal);
+        const auto [value, overflow] = expecteds[i++];
+        REQUIRE(literal->overflow == overflow);
+        if (!overflow) { REQUIRE(literal->value == value); }
+    }
+    REQUIRE(i == expecteds.size());
+    REQUIRE(l.integers().size() == expecteds.size());
+
+    // Rewinding clears the table, and relexing replaces entries instead of duplicating them
+    l.reset(input);
+    REQUIRE(l.integers().size() == 0);
+    l.consume();
+    REQUIRE(l.integers().size() == expecteds.size());
+    l.consume();
+    REQUIRE(l.integers().size() == expecteds.size());
+}
+
 TEST_CASE("Character literals") {
     Lexer l{"if'e' else'\\'\nreturn'\\r' break'\\n'\n"
             "continue'\\0' for'\\'' while'\\\\' const''\n"
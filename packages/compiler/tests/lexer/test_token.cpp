@@ -4,7 +4,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include "lexer/keywords.hpp"
 #include "lexer/token.hpp"
+#include "parser/precedence.hpp"
 
 namespace conch::tests {
 
@@ -98,4 +100,26 @@ TEST_CASE("Token formatting") {
     REQUIRE(expected == actual);
 }
 
+TEST_CASE("Token type lookup tables") {
+    for (const auto tt : ALL_PRIMITIVES) {
+        REQUIRE(is_primitive(tt));
+        REQUIRE_FALSE(is_builtin(tt));
+    }
+
+    for (const auto& [_, tt] : ALL_BUILTINS) {
+        REQUIRE(is_builtin(tt));
+        REQUIRE_FALSE(is_primitive(tt));
+    }
+
+    for (const auto& [tt, precedence] : ALL_BINDINGS) {
+        REQUIRE(binding_power(tt) == precedence);
+        REQUIRE(get_binding(tt) == Binding{tt, precedence});
+    }
+
+    REQUIRE_FALSE(is_primitive(TokenType::IDENT));
+    REQUIRE_FALSE(is_builtin(TokenType::ILLEGAL));
+    REQUIRE_FALSE(get_binding(TokenType::SEMICOLON));
+    REQUIRE(binding_power(TokenType::END) == Precedence::LOWEST);
+}
+
 } // namespace conch::tests
@@ -0,0 +1,199 @@
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "parser/parser.hpp"
+
+#include "ast/ast.hpp"
+
+#include "types.hpp"
+
+namespace conch::tests {
+
+TEST_CASE("Incremental reparsing throughput", "[.][benchmark]") {
+    std::string source;
+    for (usize i = 0; i < 5000; ++i) {
+        source += "const f" + std::to_string(i) + " := fn(x: int): int { return x * 2; };\n";
+    }
+    const TextEdit edit{source.find("x * 2", source.size() / 2) + 4, 1, "3"};
+    const auto     edited = edit.apply(source);
+
+    BENCHMARK("Full consume after an edit") {
+        Parser p{edited};
+        return p.consume().first.size();
+    };
+
+    BENCHMARK_ADVANCED("Reparse after an edit")(Catch::Benchmark::Chronometer meter) {
+        const auto                         runs = static_cast<usize>(meter.runs());
+        std::vector<Parser>                parsers(runs);
+        std::vector<ast::AST>              trees(runs);
+        std::vector<Rc<const TokenStream>> streams(runs);
+        for (usize i = 0; i < runs; ++i) {
+            parsers[i] = Parser{source};
+            trees[i]   = parsers[i].consume().first;
+            streams[i] = parsers[i].token_stream();
+            parsers[i].reset(edited);
+        }
+
+        meter.measure([&](int i) {
+            const auto run = static_cast<usize>(i);
+            return parsers[run].reparse(std::move(trees[run]), *streams[run], edit).first.size();
+        });
+    };
+}
+
+TEST_CASE("Integer literal decoding throughput", "[.][benchmark]") {
+    constexpr usize ROWS = 200000;
+    std::string     source{"const TABLE := [" + std::to_string(ROWS * 2) + "uz]int{"};
+    for (usize i = 0; i < ROWS; ++i) {
+        source += std::to_string(i * 7919) + ", 0x" + std::to_string(i % 10) + "FFFFFFF, ";
+    }
+    source += "};";
+
+    BENCHMARK("Parsing an integer dense array") {
+        Parser p{source};
+        return p.consume().first.size();
+    };
+}
+
+// Call arguments are parsed as expressions first and rolled back to explicit types on failure.
+TEST_CASE("Parser backtracking throughput", "[.][benchmark]") {
+    std::string source;
+    for (usize i = 0; i < 20000; ++i) {
+        source += "const r" + std::to_string(i) +
+                  " := call(*mut T, &mut x, *[4uz]int, &mut *mut U, *[N]T, &mut *[N]int);\n";
+    }
+
+    Parser parser{source};
+    REQUIRE(parser.consume().second.empty());
+
+    BENCHMARK("Parsing call arguments full of reference types") {
+        Parser p{source};
+        return p.consume().first.size();
+    };
+}
+
+// Every level is parsed as an array literal and then again as an array type, doubling the work.
+TEST_CASE("Speculative parsing of ambiguous nesting", "[.][benchmark]") {
+    std::string nested{"g(*[x]x)"};
+    for (usize i = 0; i < 16; ++i) { nested = "f(*[" + nested + "]x)"; }
+    const auto source = "const a := " + nested + ";";
+
+    BENCHMARK("Retrying every speculative rule") {
+        Parser p{source};
+        return p.consume().second.size();
+    };
+
+    BENCHMARK("Memoizing speculative failures") {
+        Parser p{source, ParserOptions{.memoize_speculation = true}};
+        return p.consume().second.size();
+    };
+}
+
+TEST_CASE("Expression parsing throughput", "[.][benchmark]") {
+    std::string source;
+    for (usize i = 0; i < 20000; ++i) {
+        source += "var v" + std::to_string(i) +
+                  " := (a + b * c - d / 2) * -e + f(g, h[i + 1]) % 3 == !k and l or (m < n);\n";
+    }
+
+    Parser parser{source};
+    const auto [ast, errors] = parser.consume();
+    REQUIRE(errors.empty());
+    REQUIRE(ast.size() == 20000);
+
+    BENCHMARK("Parsing operator heavy declarations") {
+        Parser p{source};
+        return p.consume().first.size();
+    };
+}
+
+TEST_CASE("Binary chain parsing", "[.][benchmark]") {
+    std::string source{"const hit := x == 0"};
+    for (usize i = 1; i < 100000; ++i) { source += " or x == " + std::to_string(i); }
+    source += ";";
+
+    BENCHMARK("Parsing into nested binaries") {
+        Parser p{source};
+        return p.consume().first.size();
+    };
+
+    BENCHMARK("Parsing into a flattened chain") {
+        Parser p{source, ParserOptions{.flatten_binary_chains = true}};
+        return p.consume().first.size();
+    };
+}
+
+TEST_CASE("AST arena allocation and teardown", "[.][benchmark]") {
+    std::string source;
+    for (usize i = 0; i < 20000; ++i) {
+        source += "const f" + std::to_string(i) +
+                  " := fn(x: int, y: *mut [4uz]int): int { return x * 2 + y[0]; };\n";
+    }
+
+    BENCHMARK("Parsing into the arena") {
+        Parser p{source};
+        return p.consume().first.size();
+    };
+
+    BENCHMARK_ADVANCED("Dropping an arena-backed AST")(Catch::Benchmark::Chronometer meter) {
+        std::vector<ast::AST> trees(static_cast<usize>(meter.runs()));
+        for (auto& tree : trees) {
+            Parser p{source};
+            tree = p.consume().first;
+        }
+        meter.measure([&](int i) { trees[static_cast<usize>(i)] = ast::AST{}; });
+    };
+}
+
+// Conch files are mostly independent declarations, which parse well on every core.
+TEST_CASE("Parallel top-level parsing", "[.][benchmark]") {
+    std::string source;
+    for (usize i = 0; i < 50000; ++i) {
+        source += "const f" + std::to_string(i) +
+                  " := fn(x: int, y: *mut [4uz]int): int { return x * 2 + y[0]; };\n";
+    }
+
+    Parser parser{source};
+    const auto [ast, errors] = parser.consume_parallel();
+    REQUIRE(errors.empty());
+    REQUIRE(ast.size() == 50000);
+
+    BENCHMARK("Parsing declarations serially") {
+        Parser p{source};
+        return p.consume().first.size();
+    };
+
+    BENCHMARK("Parsing declarations in parallel") {
+        Parser p{source};
+        return p.consume_parallel().first.size();
+    };
+}
+
+TEST_CASE("Lazy function body parsing", "[.][benchmark]") {
+    std::string source;
+    for (usize i = 0; i < 20000; ++i) {
+        source += "const f" + std::to_string(i) +
+                  " := fn(x: int): int { var y := x * 2; while (y > 0) : (y -= 1) { x += y; } "
+                  "return match (x) { 0 => 1; } else x; };\n";
+    }
+
+    Parser parser{source, ParserOptions{.lazy_function_bodies = true}};
+    const auto [ast, errors] = parser.consume();
+    REQUIRE(errors.empty());
+    REQUIRE(ast.size() == 20000);
+
+    BENCHMARK("Parsing every body") {
+        Parser p{source};
+        return p.consume().first.size();
+    };
+
+    BENCHMARK("Skipping every body") {
+        Parser p{source, ParserOptions{.lazy_function_bodies = true}};
+        return p.consume().first.size();
+    };
+}
+
+} // namespace conch::tests
@@ -0,0 +1,31 @@
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "parser/literal_pool.hpp"
+
+namespace conch::tests {
+
+TEST_CASE("Literal interning") {
+    LiteralPool pool;
+    REQUIRE(pool.size() == 0);
+
+    const auto first = pool.intern(std::string{"hello\nworld"});
+    REQUIRE(first == "hello\nworld");
+    REQUIRE(pool.contains("hello\nworld"));
+
+    // Equal literals share storage however they are interned
+    REQUIRE(pool.intern(std::string_view{"hello\nworld"}).data() == first.data());
+    REQUIRE(pool.intern(std::string{"hello\nworld"}).data() == first.data());
+    REQUIRE(pool.size() == 1);
+
+    // Small literals keep their address as the pool grows
+    const auto small = pool.intern(std::string_view{"a"});
+    for (usize i = 0; i < 1000; ++i) { (void)pool.intern(std::to_string(i)); }
+    REQUIRE(pool.intern(std::string_view{"a"}).data() == small.data());
+    REQUIRE(small == "a");
+    REQUIRE(pool.size() == 1002);
+}
+
+} // namespace conch::tests
@@ -0,0 +1,125 @@
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "parser/parser.hpp"
+
+#include "ast/ast.hpp"
+
+#include "optional.hpp"
+#include "types.hpp"
+
+namespace conch::tests {
+
+static auto nested(std::string_view open, std::string_view close, usize depth) -> std::string {
+    std::string input;
+    for (usize i = 0; i < depth; ++i) { input += open; }
+    input += "a";
+    for (usize i = 0; i < depth; ++i) { input += close; }
+    return input + ";";
+}
+
+// Parses the input, requiring that it fails on the nesting limit before anything else.
+static auto check_limited(std::string_view input, const ParserOptions& options = {}) -> void {
+    Parser p{input, options};
+    auto [_, errors] = p.consume();
+    REQUIRE_FALSE(errors.empty());
+    REQUIRE(errors.front().error() == ParserError::NESTING_LIMIT_EXCEEDED);
+}
+
+static auto check_parses(std::string_view input, const ParserOptions& options = {}) -> void {
+    Parser p{input, options};
+    auto [ast, errors] = p.consume();
+    REQUIRE(errors.empty());
+    REQUIRE(ast.size() == 1);
+}
+
+TEST_CASE("Deep nesting is rejected instead of overflowing the stack") {
+    constexpr usize DEEP = 100000;
+    check_limited(nested("(", ")", DEEP));
+    check_limited(nested("!", "", DEEP));
+    check_limited(nested("a + (", ")", DEEP));
+    check_limited(nested("f(", ")", DEEP));
+    check_limited(nested("b[", "]", DEEP));
+    check_limited(nested("{", "}", DEEP));
+
+    // Explicit types recurse through their own parser for every dimension and modifier
+    const auto deep_type = [](std::string_view repeated, usize depth) {
+        std::string input{"const x: "};
+        for (usize i = 0; i < depth; ++i) { input += repeated; }
+        return input + "i32 = 1;";
+    };
+    check_limited(deep_type("[]", 1'000'000));
+    check_limited(deep_type("*mut ", 300'000));
+    check_limited(deep_type("[4uz]&", DEEP));
+    check_parses(deep_type("[]", 64));
+    check_parses(deep_type("*mut ", 64));
+
+    // Nesting just below the limit is left alone
+    const ParserOptions defaults;
+    check_parses(nested("(", ")", defaults.max_nesting_depth - 2));
+    check_limited(nested("(", ")", defaults.max_nesting_depth));
+    check_parses(nested("-(", ")", 64));
+    check_parses(nested("f(", ")", 64));
+}
+
+TEST_CASE("Operator nesting does not use the call stack") {
+    // Groups, unary chains and binary operands unwind on the parser's own stack, so a raised
+    // limit lets generated code nest far deeper than recursion ever could
+    const ParserOptions options{.max_nesting_depth = 1'000'000};
+    check_parses(nested("(", ")", 200000), options);
+    check_parses(nested("!", "", 200000), options);
+    check_parses(nested("a * -(", ")", 100000), options);
+    check_parses(nested("a + b * (", ")", 100000), options);
+}
+
+TEST_CASE("Lazy bodies resume at the depth they were skipped at") {
+    constexpr usize     LIMIT = 32;
+    const ParserOptions eager{.max_nesting_depth = LIMIT};
+    const ParserOptions lazy{.lazy_function_bodies = true, .max_nesting_depth = LIMIT};
+
+    // Each enclosing body counts toward the limit of the functions declared inside of it
+    const auto input = [](usize depth) {
+        std::string input;
+        for (usize i = 0; i < 3; ++i) { input += "const f := fn(): int { "; }
+        input += "return " + nested("(", ")", depth);
+        for (usize i = 0; i < 3; ++i) { input += " };"; }
+        return input;
+    };
+
+    bool limited = false;
+    for (usize depth = 0; depth < LIMIT; ++depth) {
+        Parser eager_parser{input(depth), eager};
+        auto [_, expected] = eager_parser.consume();
+
+        Parser lazy_parser{input(depth), lazy};
+        auto [ast, errors] = lazy_parser.consume();
+        REQUIRE(errors.empty());
+        REQUIRE(ast.size() == 1);
+
+        // Reading a body skips the one nested inside of it, so they are read from the outside in
+        const ast::Node*           stmt = ast[0].get();
+        Optional<ParserDiagnostic> failure;
+        while (stmt->is<ast::DeclStatement>()) {
+            const auto& decl = ast::Node::as<ast::DeclStatement>(*stmt);
+            const auto& fn   = ast::Node::as<ast::FunctionExpression>(decl.get_value());
+            if (auto loaded = fn.load_body(); !loaded) {
+                failure = std::move(loaded.error());
+                break;
+            }
+            if (fn.get_body().empty()) { break; }
+            stmt = fn.get_body().begin()->get();
+        }
+
+        REQUIRE(failure.has_value() != expected.empty());
+        if (!expected.empty()) {
+            REQUIRE(expected.front().error() == ParserError::NESTING_LIMIT_EXCEEDED);
+            REQUIRE(failure->error() == ParserError::NESTING_LIMIT_EXCEEDED);
+            limited = true;
+        }
+    }
+    REQUIRE(limited);
+}
+
+} // namespace conch::tests
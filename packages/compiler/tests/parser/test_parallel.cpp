@@ -0,0 +1,89 @@
+#include <string>
+#include <vector>
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "ast/helpers.hpp"
+
+#include "parser/parser.hpp"
+
+#include "ast/ast.hpp"
+
+#include "types.hpp"
+
+namespace conch::tests {
+
+// Parses the input both ways, requiring identical trees and diagnostics in the same order.
+static auto check_parallel(std::string_view input, const ParallelParseOptions& options) -> void {
+    Parser serial{input};
+    auto [expected, expected_errors] = serial.consume();
+
+    Parser parallel{input};
+    auto [actual, actual_errors] = parallel.consume_parallel(options);
+    REQUIRE(parallel.current_token_is(TokenType::END));
+
+    helpers::require_same_parse(actual, expected, actual_errors, expected_errors);
+}
+
+TEST_CASE("Parallel parsing matches serial parsing") {
+    std::string input;
+    for (usize i = 0; i < 200; ++i) {
+        const auto n = std::to_string(i);
+        input += "const f" + n + " := fn(x: int): int { return x * " + n + "; };\n";
+        input += "var s" + n + " := \"row\\t" + n + "\";;\n";
+    }
+
+    // Tasks of a single statement each, split over more workers than there are cores
+    check_parallel(input, {.threads = 8, .min_task_tokens = 1});
+    check_parallel(input, {.threads = 3, .min_task_tokens = 64});
+
+    // Small inputs and single workers fall back to a serial parse
+    check_parallel(input, {.threads = 1, .min_task_tokens = 1});
+    check_parallel("const a := 1;", {.threads = 4, .min_task_tokens = 1});
+    check_parallel("", {.threads = 4, .min_task_tokens = 1});
+}
+
+TEST_CASE("Parallel parsing across guessed boundaries") {
+    // The else branch continues a statement past a top level semicolon
+    check_parallel("if (a) b; else c; d; if (e) f; g;", {.threads = 4, .min_task_tokens = 1});
+
+    // Recovery skips to the next semicolon, which can sit inside of a block
+    check_parallel("const a := ; b; const c := fn(): int { d e; f; }; g; h;",
+                   {.threads = 4, .min_task_tokens = 1});
+    check_parallel("var = 2; 3 +; { a; }; } ; ;; x := ;", {.threads = 4, .min_task_tokens = 1});
+}
+
+TEST_CASE("Parallel lazy parsing loads bodies like serial parsing") {
+    constexpr usize FUNCTIONS = 64;
+    std::string     input;
+    for (usize i = 0; i < FUNCTIONS; ++i) {
+        input += "const f" + std::to_string(i) + " := fn(): int { a b; };\n";
+    }
+
+    // Workers claim several tasks each, and every task a worker claimed skips into its one source
+    const auto failures = [&](auto&& consume) {
+        Parser parser{input, {.lazy_function_bodies = true}};
+        auto [ast, errors] = consume(parser);
+        helpers::check_errors<ParserDiagnostic>(errors);
+        REQUIRE(ast.size() == FUNCTIONS);
+
+        std::vector<ParserDiagnostic> loaded;
+        for (const auto& node : ast) {
+            const auto& decl = helpers::try_into<ast::DeclStatement>(*node);
+            const auto& fn   = helpers::try_into<ast::FunctionExpression>(decl.get_value());
+            auto        body = fn.load_body();
+            REQUIRE_FALSE(body);
+            REQUIRE(fn.is_body_deferred());
+            loaded.push_back(std::move(body.error()));
+        }
+        return loaded;
+    };
+
+    const auto expected = failures([](Parser& p) { return p.consume(); });
+    const auto actual   = failures(
+        [](Parser& p) { return p.consume_parallel({.threads = 4, .min_task_tokens = 1}); });
+    REQUIRE(actual == expected);
+}
+
+} // namespace conch::tests
@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <array>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "ast/helpers.hpp"
+
+#include "parser/parser.hpp"
+
+#include "ast/ast.hpp"
+
+#include "types.hpp"
+
+namespace conch::tests {
+
+// Reparses the edited source, requiring the same tree, extents and diagnostics as a fresh parse.
+// Returns how many top level nodes were moved over from the previous tree.
+static auto check_reparse(std::string_view     source,
+                          const TextEdit&      edit,
+                          const ParserOptions& options = {}) -> usize {
+    Parser parser{source, options};
+    auto [previous, _]         = parser.consume();
+    const auto previous_stream = parser.token_stream();
+
+    std::unordered_set<const ast::Node*> previous_nodes;
+    for (const auto& node : previous) { previous_nodes.insert(node.get()); }
+
+    const auto edited = edit.apply(source);
+    Parser     fresh{edited, options};
+    auto [expected, expected_errors] = fresh.consume();
+
+    parser.reset(edited);
+    auto [actual, actual_errors] = parser.reparse(std::move(previous), *previous_stream, edit);
+    REQUIRE(parser.current_token_is(TokenType::END));
+
+    helpers::require_same_parse(actual, expected, actual_errors, expected_errors);
+    REQUIRE(std::ranges::equal(actual.extents(), expected.extents()));
+
+    // Reused statements must have moved to where the fresh parse found them in the edited input
+    for (usize i = 0; i < actual.size(); ++i) {
+        const auto& token = actual[i]->get_token();
+        REQUIRE(token == expected[i]->get_token());
+        REQUIRE(token.slice.data() == expected[i]->get_token().slice.data());
+    }
+
+    return static_cast<usize>(std::ranges::count_if(
+        actual, [&](const auto& node) { return previous_nodes.contains(node.get()); }));
+}
+
+TEST_CASE("Reparsing reuses statements around an edit") {
+    constexpr std::string_view source{"const a := 1;\n"
+                                      "const f := fn(x: int): int { return x * 2; };\n"
+                                      "var b := f(a);\n"
+                                      "if (b) c; else d;\n"
+                                      "const s := \"text\";\n"};
+    const auto                 inside_f = source.find("x * 2") + 4;
+
+    // Edits that keep the line count leave every other statement where it was, and an edit inside
+    // of a block keeps the statement holding it
+    REQUIRE(check_reparse(source, {.offset = inside_f, .length = 1, .replacement = "31"}) == 5);
+    REQUIRE(check_reparse(source, {.offset = inside_f, .length = 0, .replacement = " "}) == 5);
+
+    // Statements after an edit that adds lines or moves columns are shifted along with it
+    REQUIRE(check_reparse(source, {.offset = inside_f, .length = 0, .replacement = "\n"}) == 5);
+    REQUIRE(check_reparse(source, {.offset = inside_f, .length = 1, .replacement = "\n\n3"}) == 5);
+    REQUIRE(check_reparse(source,
+                          {.offset = source.find("var b"), .length = 0, .replacement = "  "}) ==
+            4);
+
+    // The last statement looked at the end of the input, which is where new statements appear
+    REQUIRE(check_reparse(source, {.offset = source.size(), .length = 0, .replacement = "e;"}) ==
+            4);
+
+    // Skipped function bodies stay readable through the tree they were reused into
+    REQUIRE(check_reparse(source,
+                          {.offset = source.find("f(a)") + 2, .length = 1, .replacement = "b"},
+                          {.lazy_function_bodies = true}) == 4);
+    REQUIRE(check_reparse(source,
+                          {.offset = inside_f, .length = 1, .replacement = "\n3"},
+                          {.lazy_function_bodies = true}) == 5);
+}
+
+TEST_CASE("Reparsing only parses the innermost block around an edit") {
+    constexpr std::string_view source{"const f := fn(x: int): int {\n"
+                                      "    var y := x;\n"
+                                      "    {\n"
+                                      "        y = y + 1;\n"
+                                      "    }\n"
+                                      "    return y;\n"
+                                      "};\n"};
+    const TextEdit edit{.offset = source.find("1;"), .length = 1, .replacement = "\n  20"};
+    const auto     edited = edit.apply(source);
+
+    // Edits around the inner block take the whole function body with them instead
+    REQUIRE(check_reparse(source, edit) == 1);
+    REQUIRE(check_reparse(source, {.offset = source.find("y;"), .length = 1, .replacement = "z"}) ==
+            1);
+    check_reparse(source, {.offset = source.find("    }"), .length = 5, .replacement = ""});
+
+    const auto body = [](const ast::AST& ast) -> const ast::BlockStatement& {
+        const auto& decl = ast::Node::as<ast::DeclStatement>(*ast[0]);
+        const auto& fn   = ast::Node::as<ast::FunctionExpression>(decl.get_value());
+        REQUIRE(fn.load_body());
+        return fn.get_body();
+    };
+
+    Parser parser{source};
+    auto [previous, _]         = parser.consume();
+    const auto previous_stream = parser.token_stream();
+    const auto declaration     = body(previous).begin()->get();
+    const auto inner           = (body(previous).begin() + 1)->get();
+    const auto jump            = (body(previous).begin() + 2)->get();
+    const auto assignment      = ast::Node::as<ast::BlockStatement>(*inner).begin()->get();
+
+    // Only the statements of the inner block are new, the block itself and its neighbours moved
+    parser.reset(edited);
+    auto [actual, errors] = parser.reparse(std::move(previous), *previous_stream, edit);
+    REQUIRE(errors.empty());
+    REQUIRE(body(actual).begin()->get() == declaration);
+    REQUIRE((body(actual).begin() + 1)->get() == inner);
+    REQUIRE((body(actual).begin() + 2)->get() == jump);
+    REQUIRE(ast::Node::as<ast::BlockStatement>(*inner).begin()->get() != assignment);
+    REQUIRE(jump->get_token().line == 7);
+
+    // A skipped body around the edit is kept skipped, and reads the edited tokens once loaded
+    const ParserOptions lazy{.lazy_function_bodies = true};
+    Parser              lazy_parser{source, lazy};
+    auto [skipped, skipped_errors] = lazy_parser.consume();
+    const auto skipped_stream      = lazy_parser.token_stream();
+    const auto statement           = skipped[0].get();
+
+    lazy_parser.reset(edited);
+    auto [reused, reused_errors] = lazy_parser.reparse(std::move(skipped), *skipped_stream, edit);
+    REQUIRE(reused_errors.empty());
+    REQUIRE(reused[0].get() == statement);
+
+    const auto& decl = ast::Node::as<ast::DeclStatement>(*reused[0]);
+    REQUIRE(ast::Node::as<ast::FunctionExpression>(decl.get_value()).is_body_deferred());
+    Parser fresh{edited};
+    auto [expected, expected_errors] = fresh.consume();
+    REQUIRE(body(reused) == body(expected));
+}
+
+TEST_CASE("Reparsing matches a fresh parse for any edit") {
+    constexpr std::string_view source{"const a := 1; var = 2;\n"
+                                      "if (a) b; else c; d;\n"
+                                      "const f := fn(): int { e f; };\n"
+                                      "{ g; }; } ;; h := ;\n"
+                                      "i(\"j\", 3uz);\n"};
+
+    constexpr auto replacements = std::to_array<std::string_view>({"x", ";", "\n", "{", "}"});
+    for (usize offset = 0; offset <= source.size(); ++offset) {
+        for (const auto replacement : replacements) {
+            check_reparse(source, {.offset = offset, .length = 0, .replacement = replacement});
+        }
+        if (offset < source.size()) {
+            check_reparse(source, {.offset = offset, .length = 1, .replacement = ""});
+        }
+    }
+}
+
+TEST_CASE("Reparsing moves nested tokens behind a line changing edit") {
+    constexpr std::string_view source{"const a := 1;\n"
+                                      "const f := fn(x: int): int { return x * 2; };\n"};
+    const TextEdit             edit{.offset = 0, .length = 0, .replacement = "\n  "};
+    const auto                 edited = edit.apply(source);
+
+    const auto return_token = [](const ast::AST& ast) -> const Token& {
+        const auto& decl = ast::Node::as<ast::DeclStatement>(*ast[1]);
+        const auto& fn   = ast::Node::as<ast::FunctionExpression>(decl.get_value());
+        REQUIRE(fn.load_body());
+        return (*fn.get_body().begin())->get_token();
+    };
+
+    for (const auto lazy : {false, true}) {
+        Parser parser{source, {.lazy_function_bodies = lazy}};
+        auto [previous, _]         = parser.consume();
+        const auto previous_stream = parser.token_stream();
+        const auto reused          = previous[1].get();
+
+        parser.reset(edited);
+        auto [actual, errors] = parser.reparse(std::move(previous), *previous_stream, edit);
+        REQUIRE(errors.empty());
+        REQUIRE(actual[1].get() == reused);
+
+        // Shifting a skipped body leaves it skipped until it is read from the edited source
+        const auto& decl = ast::Node::as<ast::DeclStatement>(*actual[1]);
+        REQUIRE(ast::Node::as<ast::FunctionExpression>(decl.get_value()).is_body_deferred() ==
+                lazy);
+
+        Parser fresh{edited};
+        auto [expected, expected_errors] = fresh.consume();
+        REQUIRE(return_token(actual) == return_token(expected));
+        REQUIRE(return_token(actual).slice.data() == return_token(expected).slice.data());
+        REQUIRE(return_token(actual).line == 3);
+    }
+}
+
+TEST_CASE("Reparsing keeps only the lazy body failures left in the tree") {
+    constexpr std::string_view source{"const f := fn(): int { a b; };\n"
+                                      "c;\n"
+                                      "const g := fn(): int { d e; };\n"};
+    const TextEdit edit{.offset = source.find(" b;"), .length = 2, .replacement = ""};
+    const auto     edited = edit.apply(source);
+
+    const auto load_body = [](const ast::AST& ast, usize idx) {
+        const auto& decl = ast::Node::as<ast::DeclStatement>(*ast[idx]);
+        return ast::Node::as<ast::FunctionExpression>(decl.get_value()).load_body();
+    };
+
+    Parser parser{source, {.lazy_function_bodies = true}};
+    auto [previous, _]         = parser.consume();
+    const auto previous_stream = parser.token_stream();
+    REQUIRE_FALSE(load_body(previous, 0));
+    REQUIRE_FALSE(load_body(previous, 2));
+
+    // Fixing f lets its body load, while g is reused with a body that still fails
+    parser.reset(edited);
+    auto [actual, errors] = parser.reparse(std::move(previous), *previous_stream, edit);
+    REQUIRE(errors.empty());
+
+    Parser fresh{edited, {.lazy_function_bodies = true}};
+    auto [expected, expected_errors] = fresh.consume();
+    REQUIRE(load_body(actual, 0));
+    REQUIRE(load_body(expected, 0));
+
+    const auto actual_failure   = load_body(actual, 2);
+    const auto expected_failure = load_body(expected, 2);
+    REQUIRE_FALSE(actual_failure);
+    REQUIRE_FALSE(expected_failure);
+    REQUIRE(actual_failure.error() == expected_failure.error());
+}
+
+TEST_CASE("Reparsed trees keep owned sources alive") {
+    constexpr std::string_view source{"const a := 1;\nvar b := a;\n"};
+    const TextEdit             edit{.offset = source.find("1"), .length = 1, .replacement = "2"};
+    const auto                 edited = edit.apply(source);
+
+    // Nothing but the trees owns either buffer once each parse is done
+    Parser parser{make_rc<std::string>(source)};
+    auto [previous, _]          = parser.consume();
+    const auto previous_stream  = parser.token_stream();
+    const auto reused_statement = previous[1].get();
+
+    parser.reset(make_rc<std::string>(edited));
+    auto [actual, errors] = parser.reparse(std::move(previous), *previous_stream, edit);
+    parser.reset();
+
+    Parser fresh{edited};
+    auto [expected, expected_errors] = fresh.consume();
+    helpers::require_same_parse(actual, expected, errors, expected_errors);
+    REQUIRE(actual[1].get() == reused_statement);
+}
+
+} // namespace conch::tests
@@ -0,0 +1,84 @@
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "allocation_helpers.hpp"
+#include "ast/helpers.hpp"
+
+#include "parser/parser.hpp"
+
+#include "ast/ast.hpp"
+
+#include "types.hpp"
+
+namespace conch::tests {
+
+// Nests array dimensions that parse as both an array literal and an array type before failing.
+static auto ambiguous_dimensions(usize depth) -> std::string {
+    std::string input{"g(*[x]x)"};
+    for (usize i = 0; i < depth; ++i) { input = "f(*[" + input + "]x)"; }
+    return "const a := " + input + ";";
+}
+
+// Parses the input with and without memoization, requiring identical results.
+static auto check_memoized(std::string_view input, const ParserOptions& options = {}) -> void {
+    Parser plain{input, options};
+    auto [expected, expected_errors] = plain.consume();
+
+    auto memoized_options                = options;
+    memoized_options.memoize_speculation = true;
+    Parser memoized{input, memoized_options};
+    auto [actual, actual_errors] = memoized.consume();
+
+    helpers::require_same_parse(actual, expected, actual_errors, expected_errors);
+}
+
+TEST_CASE("Memoized speculation matches plain parsing") {
+    check_memoized("a(&mut P, *[4uz]int, &b, *mut T); c(d(&mut *[N]T, e), [_]int{1, 2});");
+    check_memoized("f(*[g(*[x]x)]x); h(&mut, *); i(*[j(&mut]x); k := 1;");
+    check_memoized("const f := fn(x: *[N]*mut T): *fn(a: &[2uz]int): void { g(&mut x); };");
+
+    for (usize depth = 0; depth < 8; ++depth) { check_memoized(ambiguous_dimensions(depth)); }
+
+    // Failures recorded near the limit are not replayed at depths where the limit comes first
+    check_memoized(ambiguous_dimensions(12), {.max_nesting_depth = 20});
+    check_memoized("f((((*[a(b)]x))), ((((*[a(b)]x)))));", {.max_nesting_depth = 6});
+}
+
+TEST_CASE("Memoized speculation stays linear on ambiguous nesting") {
+    // Without memoization this would parse the innermost call 2^40 times
+    ParserOptions options;
+    options.memoize_speculation = true;
+
+    const auto input = ambiguous_dimensions(40);
+    Parser     p{input, options};
+    auto [ast, errors] = p.consume();
+    REQUIRE(ast.empty());
+    REQUIRE(errors.size() == 1);
+    REQUIRE(p.current_token_is(TokenType::END));
+}
+
+TEST_CASE("Failed speculation does not allocate") {
+    // The call argument rule tries an expression before falling back to a type
+    Parser parser{"f(&mut *mut T);"};
+    parser.advance();
+
+    const auto mallocs = allocation_count();
+    const auto failed  = [&] {
+        Parser::Transaction transaction{parser};
+        parser.advance();
+        return parser.parse_expression();
+    }();
+    const auto allocations = allocation_count() - mallocs;
+
+    REQUIRE_FALSE(failed);
+    REQUIRE(allocations == 0);
+    REQUIRE(parser.current_token_is(TokenType::LPAREN));
+
+    // The message is only formatted once it is read
+    REQUIRE(failed.error().error() == ParserError::MISSING_PREFIX_PARSER);
+    REQUIRE(failed.error().message() == "No prefix parse function for STAR_MUT(*mut) found");
+}
+
+} // namespace conch::tests
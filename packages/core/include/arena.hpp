@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "memory.hpp"
+#include "types.hpp"
+
+namespace conch {
+
+// A bump allocator that carves memory out of large chunks and releases it all at once.
+//
+// Nothing placed in an arena is destroyed individually, so objects living in one must not own
+// memory outside of it. Chunks come straight from the OS and grow geometrically, so dropping even
+// a large arena is a handful of unmaps.
+class Arena {
+  public:
+    static constexpr usize DEFAULT_CHUNK_SIZE = 64 * 1024;
+    static constexpr usize MAX_CHUNK_SIZE     = 64 * 1024 * 1024;
+
+  public:
+    Arena() noexcept = default;
+    explicit Arena(usize chunk_size) noexcept : next_chunk_size_{chunk_size} {}
+    ~Arena();
+
+    Arena(const Arena&)                    = delete;
+    auto operator=(const Arena&) -> Arena& = delete;
+    Arena(Arena&& other) noexcept;
+    auto operator=(Arena&& other) noexcept -> Arena&;
+
+    // Returns uninitialized storage, throwing std::bad_alloc if the OS refuses a new chunk.
+    [[nodiscard]] auto allocate(usize size, usize alignment = alignof(std::max_align_t)) -> void* {
+        const auto aligned = (cursor_ + alignment - 1) & ~(alignment - 1);
+        if (aligned + size <= limit_) {
+            cursor_ = aligned + size;
+            used_ += size;
+            return reinterpret_cast<void*>(aligned);
+        }
+        return allocate_slow(size, alignment);
+    }
+
+    template <typename T, typename... Args> [[nodiscard]] auto make(Args&&... args) -> T* {
+        return std::construct_at(static_cast<T*>(allocate(sizeof(T), alignof(T))),
+                                 std::forward<Args>(args)...);
+    }
+
+    // Returns every chunk to the OS, invalidating everything allocated so far.
+    auto release() noexcept -> void;
+
+    [[nodiscard]] auto chunk_count() const noexcept -> usize { return chunks_.size(); }
+    [[nodiscard]] auto bytes_used() const noexcept -> usize { return used_; }
+
+  private:
+    struct Chunk {
+        void* data;
+        usize size;
+    };
+
+    auto allocate_slow(usize size, usize alignment) -> void*;
+
+  private:
+    std::vector<Chunk> chunks_;
+    std::uintptr_t     cursor_{0};
+    std::uintptr_t     limit_{0};
+    usize              used_{0};
+    usize              next_chunk_size_{DEFAULT_CHUNK_SIZE};
+};
+
+// A standard allocator that draws from an arena, falling back to the heap when it has none.
+//
+// Deallocation is a no-op for arena memory, so containers that grow leave their old buffers in
+// the arena until it is dropped.
+template <typename T> class ArenaAllocator {
+  public:
+    using value_type                             = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+  public:
+    ArenaAllocator() noexcept = default;
+
+    // cppcheck-suppress noExplicitConstructor
+    ArenaAllocator(Arena* arena) noexcept : arena_{arena} {}
+
+    // cppcheck-suppress noExplicitConstructor
+    template <typename U> ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+        : arena_{other.arena()} {}
+
+    [[nodiscard]] auto allocate(usize n) -> T* {
+        if (arena_) { return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T))); }
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    auto deallocate(T* ptr, usize n) noexcept -> void {
+        if (!arena_) { std::allocator<T>{}.deallocate(ptr, n); }
+    }
+
+    [[nodiscard]] auto arena() const noexcept -> Arena* { return arena_; }
+
+    template <typename U>
+    friend auto operator==(const ArenaAllocator& lhs, const ArenaAllocator<U>& rhs) noexcept
+        -> bool {
+        return lhs.arena_ == rhs.arena();
+    }
+
+  private:
+    Arena* arena_{nullptr};
+};
+
+template <typename T> using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+// Constructs a value in the arena, returning a box that leaves its storage to the arena.
+template <typename T, typename... Args>
+auto make_arena_box(Arena& arena, Args&&... args) -> Box<T> {
+    return Box<T>{arena.make<T>(std::forward<Args>(args)...), BoxDeleter{true}};
+}
+
+} // namespace conch
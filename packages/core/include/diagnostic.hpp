@@ -1,8 +1,13 @@
 #pragma once
 
+#include <array>
+#include <concepts>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
+#include <variant>
 
 #include <magic_enum/magic_enum.hpp>
 
@@ -21,12 +26,59 @@ namespace detail {
 
 } // namespace detail
 
+// A message kept as its format string and arguments, so building one never allocates. Formatting
+// happens when the diagnostic is read, and string arguments must outlive the diagnostic.
+class DiagnosticMessage {
+  public:
+    using Arg = std::variant<std::string_view, i64, u64, char>;
+
+    static constexpr usize MAX_ARGS = 3;
+
+    template <typename... Args>
+        requires(sizeof...(Args) <= MAX_ARGS)
+    explicit DiagnosticMessage(fmt::format_string<Args...> format, Args&&... args) noexcept
+        : format_{format}, args_{to_arg(args)...}, arg_count_{sizeof...(Args)} {}
+
+    [[nodiscard]] auto render() const -> std::string;
+
+    auto operator==(const DiagnosticMessage& other) const noexcept -> bool = default;
+
+  private:
+    template <typename T> static auto to_arg(const T& arg) noexcept -> Arg {
+        // Characters and booleans are integral too, but would print as numbers if widened
+        static_assert(!std::same_as<T, bool> && !std::same_as<T, wchar_t> &&
+                          !std::same_as<T, char8_t> && !std::same_as<T, char16_t> &&
+                          !std::same_as<T, char32_t>,
+                      "Only narrow characters can be deferred diagnostic arguments");
+        if constexpr (std::same_as<T, char>) {
+            return arg;
+        } else if constexpr (std::signed_integral<T>) {
+            return static_cast<i64>(arg);
+        } else if constexpr (std::unsigned_integral<T>) {
+            return static_cast<u64>(arg);
+        } else {
+            // Owning strings are destroyed long before the message is rendered, so only views fit
+            static_assert(std::same_as<T, std::string_view> || std::convertible_to<T, const char*>,
+                          "Only string views and literals can be deferred diagnostic arguments");
+            return std::string_view{arg};
+        }
+    }
+
+  private:
+    fmt::string_view          format_;
+    std::array<Arg, MAX_ARGS> args_{};
+    usize                     arg_count_;
+};
+
+// An error with an optional message and location. Deferred messages borrow their string arguments,
+// which for parser diagnostics are token slices, so those must not outlive the source they cite.
 template <typename E>
     requires std::is_scoped_enum_v<E>
 class Diagnostic {
   public:
     Diagnostic() = delete;
     explicit Diagnostic(E err) : error_{err} {}
+    explicit Diagnostic(std::string msg, E err) : message_{std::move(msg)}, error_{err} {}
     explicit Diagnostic(E err, usize line, usize column)
         : error_{err}, loc_{SourceLocation{line, column}} {}
     explicit Diagnostic(std::string msg, E err, usize line, usize column)
@@ -36,26 +88,44 @@ class Diagnostic {
     explicit Diagnostic(std::string msg, E err, const T& t)
         : message_{std::move(msg)}, error_{err}, loc_{SourceInfo<T>::get(t)} {}
 
+    template <Locateable T>
+    explicit Diagnostic(DiagnosticMessage msg, E err, const T& t)
+        : message_{std::move(msg)}, error_{err}, loc_{SourceInfo<T>::get(t)} {}
+
     template <Locateable T>
     explicit Diagnostic(E err, T t) : error_{err}, loc_{SourceInfo<T>::get(t)} {}
 
     explicit Diagnostic(Diagnostic& other, E err) noexcept
         : message_{std::move(other.message_)}, error_{err}, loc_{std::move(other.loc_)} {}
 
-    auto has_msg() const noexcept -> bool { return message_.has_value(); }
+    auto has_msg() const noexcept -> bool {
+        return !std::holds_alternative<std::monostate>(message_);
+    }
     auto error() const noexcept -> E { return error_; }
     auto set_err(E err) noexcept -> void { error_ = err; }
 
-    [[nodiscard]] auto to_string() const noexcept -> std::string {
-        return detail::format_diagnostic(message_, magic_enum::enum_name(error_), loc_);
+    [[nodiscard]] auto message() const -> std::optional<std::string> {
+        if (const auto* text = std::get_if<std::string>(&message_)) { return *text; }
+        if (const auto* deferred = std::get_if<DiagnosticMessage>(&message_)) {
+            return deferred->render();
+        }
+        return std::nullopt;
+    }
+
+    // Rendering a deferred message formats it, which can throw.
+    [[nodiscard]] auto to_string() const -> std::string {
+        return detail::format_diagnostic(message(), magic_enum::enum_name(error_), loc_);
     }
 
-    auto operator==(const Diagnostic& other) const noexcept -> bool {
-        return message_ == other.message_ && error_ == other.error_ && loc_ == other.loc_;
+    // Messages held the same way compare without formatting, mixed ones compare by their text
+    auto operator==(const Diagnostic& other) const -> bool {
+        if (error_ != other.error_ || loc_ != other.loc_) { return false; }
+        if (message_.index() == other.message_.index()) { return message_ == other.message_; }
+        return message() == other.message();
     }
 
   private:
-    std::optional<std::string>    message_{};
+    std::variant<std::monostate, std::string, DiagnosticMessage> message_{};
     E                             error_;
     std::optional<SourceLocation> loc_{};
 
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "source_loc.hpp"
+#include "types.hpp"
+
+namespace conch {
+
+// Maps byte offsets in a source buffer to line and column numbers on demand.
+//
+// Lines and columns follow the lexer's convention: lines start at 1, the first byte of a line is
+// column 1, and a newline byte is attributed to the line it starts at column 0.
+class LineIndex {
+  public:
+    LineIndex() noexcept = default;
+    explicit LineIndex(std::string_view source);
+
+    [[nodiscard]] auto locate(usize offset) const noexcept -> SourceLocation;
+    [[nodiscard]] auto line_count() const noexcept -> usize { return line_starts_.size(); }
+
+    // Returns the offset of the first byte of the 1-based line.
+    [[nodiscard]] auto line_start(usize line) const noexcept -> usize {
+        return line_starts_[line - 1];
+    }
+
+  private:
+    std::string_view   source_{};
+    std::vector<usize> line_starts_{0};
+};
+
+} // namespace conch
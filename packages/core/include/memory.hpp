@@ -5,19 +5,37 @@
 
 namespace conch {
 
-template <typename T> using Box = std::unique_ptr<T>;
+// Frees heap-allocated boxes. Boxes carved from an arena leave both storage and destruction to
+// the arena, so dropping an arena-backed tree never walks its nodes.
+class BoxDeleter {
+  public:
+    constexpr BoxDeleter() noexcept = default;
+    constexpr explicit BoxDeleter(bool arena_owned) noexcept : arena_owned_{arena_owned} {}
+
+    template <typename T> constexpr auto operator()(T* ptr) const noexcept -> void {
+        if (!arena_owned_) { delete ptr; }
+    }
+
+    [[nodiscard]] constexpr auto arena_owned() const noexcept -> bool { return arena_owned_; }
+
+  private:
+    bool arena_owned_{false};
+};
+
+template <typename T> using Box = std::unique_ptr<T, BoxDeleter>;
 template <typename T, typename... Args> constexpr auto make_box(Args&&... args) -> Box<T> {
-    return std::make_unique<T>(std::forward<Args>(args)...);
+    return Box<T>{new T(std::forward<Args>(args)...)};
 }
 
-// Makes a new box from an existing pointer
+// Makes a new box from an existing heap pointer
 template <typename T, typename P> constexpr auto box_from(P* ptr) -> Box<T> {
-    return std::unique_ptr<T>(static_cast<T*>(ptr));
+    return Box<T>{static_cast<T*>(ptr)};
 }
 
 // Makes a new box from an existing box, changing the type as requested
 template <typename T, typename P> constexpr auto box_into(Box<P>&& ptr) -> Box<T> {
-    return std::unique_ptr<T>(static_cast<T*>(ptr.release()));
+    const auto deleter = ptr.get_deleter();
+    return Box<T>{static_cast<T*>(ptr.release()), deleter};
 }
 
 template <typename T> using Rc = std::shared_ptr<T>;
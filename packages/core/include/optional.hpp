@@ -4,6 +4,8 @@
 #include <optional>
 #include <type_traits>
 
+#include "memory.hpp"
+
 namespace conch {
 
 template <typename T> class OptionalRef {
@@ -60,21 +62,19 @@ template <typename T> auto safe_eq(const Optional<T>& a, const Optional<T>& b) n
     return *a == *b;
 }
 
-// Compares two unique pointers by assuming that both are valid.
+// Compares two boxes by assuming that both are valid.
 template <typename T>
-auto unsafe_eq(const Optional<std::unique_ptr<T>>& a,
-               const Optional<std::unique_ptr<T>>& b,
+auto unsafe_eq(const Optional<Box<T>>& a,
+               const Optional<Box<T>>& b,
                bool (*cmp)(const T&, const T&)) noexcept -> bool {
     if (a.has_value() != b.has_value()) { return false; }
     if (!a.has_value()) { return true; }
     return cmp(**a, **b);
 }
 
-// Compares two unique pointers by assuming that both are valid, using the default equality
-// operator.
+// Compares two boxes by assuming that both are valid, using the default equality operator.
 template <typename T>
-auto unsafe_eq(const Optional<std::unique_ptr<T>>& a,
-               const Optional<std::unique_ptr<T>>& b) noexcept -> bool {
+auto unsafe_eq(const Optional<Box<T>>& a, const Optional<Box<T>>& b) noexcept -> bool {
     return unsafe_eq<T>(a, b, [](const T& ae, const T& be) { return ae == be; });
 }
 
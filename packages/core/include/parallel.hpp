@@ -0,0 +1,37 @@
+#pragma once
+
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "types.hpp"
+
+namespace conch::parallel {
+
+// Calls `work(i)` for each i below `count`, the first on the calling thread and every other one on
+// a thread of its own, returning once all of them are done. Threads are joined before anything
+// propagates, and the exception thrown for the lowest index is rethrown after they are.
+template <typename F> auto fork_join(usize count, F&& work) -> void {
+    if (count == 0) { return; }
+
+    std::vector<std::exception_ptr> errors(count);
+    const auto                      guarded = [&](usize i) noexcept {
+        try {
+            work(i);
+        } catch (...) { errors[i] = std::current_exception(); }
+    };
+
+    {
+        // Destroying a jthread joins it, so failing to spawn one still waits for the others
+        std::vector<std::jthread> workers;
+        workers.reserve(count - 1);
+        for (usize i = 1; i < count; ++i) { workers.emplace_back(guarded, i); }
+        guarded(0);
+    }
+
+    for (const auto& error : errors) {
+        if (error) { std::rethrow_exception(error); }
+    }
+}
+
+} // namespace conch::parallel
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "optional.hpp"
+#include "types.hpp"
+
+namespace conch {
+
+// A collision-free string lookup table over a fixed set of keys, generated at compile time.
+//
+// Keys are hashed from their length and the bytes at four positions: the first two after the
+// prefix shared by every key and the last two. A lookup is therefore a single multiplicative hash
+// and one string comparison against the only candidate that can match.
+template <typename V, usize N> class PerfectHashMap {
+  public:
+    using Entry = std::pair<std::string_view, V>;
+
+    static_assert(N > 0 && N < std::numeric_limits<u8>::max(), "Slots are stored as u8 indices");
+
+    // Keep the load factor low enough that a collision-free seed is found after a few attempts.
+    static constexpr usize TABLE_BITS = std::bit_width(std::bit_ceil(N) * 8) - 1;
+    static constexpr usize TABLE_SIZE = usize{1} << TABLE_BITS;
+
+  public:
+    consteval explicit PerfectHashMap(const std::array<Entry, N>& entries) : entries_{entries} {
+        min_len_ = std::ranges::min(entries_, {}, [](const Entry& e) { return e.first.size(); })
+                       .first.size();
+        max_len_ = std::ranges::max(entries_, {}, [](const Entry& e) { return e.first.size(); })
+                       .first.size();
+
+        // The shared prefix carries no information so the sampled bytes start after it
+        if (min_len_ < 2) { throw std::logic_error{"Keys must be at least two bytes long"}; }
+        const auto& first = entries_.front().first;
+        while (skip_ + 2 < min_len_ && std::ranges::all_of(entries_, [&](const Entry& e) {
+                   return e.first[skip_] == first[skip_];
+               })) {
+            skip_ += 1;
+        }
+
+        for (usize i = 0; i < N; ++i) {
+            for (usize j = i + 1; j < N; ++j) {
+                if (sample(entries_[i].first) == sample(entries_[j].first)) {
+                    throw std::logic_error{"Sampled bytes do not distinguish every key"};
+                }
+            }
+        }
+
+        // With the table kept sparse a handful of seeds is almost always enough
+        constexpr u64 MAX_SEED = 1 << 12;
+        for (seed_ = 0; seed_ < MAX_SEED; ++seed_) {
+            if (try_seed()) { return; }
+        }
+        throw std::logic_error{"No collision-free seed found for the given keys"};
+    }
+
+    [[nodiscard]] constexpr auto find(std::string_view key) const noexcept -> Optional<Entry> {
+        if (key.size() < min_len_ || key.size() > max_len_) { return nullopt; }
+
+        const auto slot = slots_[hash(key)];
+        if (slot == 0) { return nullopt; }
+
+        const auto& entry = entries_[slot - 1];
+        if (entry.first != key) { return nullopt; }
+        return entry;
+    }
+
+    [[nodiscard]] constexpr auto contains(std::string_view key) const noexcept -> bool {
+        return find(key).has_value();
+    }
+
+    [[nodiscard]] constexpr auto entries() const noexcept -> const std::array<Entry, N>& {
+        return entries_;
+    }
+
+  private:
+    // Packs the length and sampled bytes of a key into one word, assuming the key is at least as
+    // long as the shortest entry.
+    [[nodiscard]] constexpr auto sample(std::string_view key) const noexcept -> u64 {
+        const auto at = [&key](usize i) noexcept {
+            return static_cast<u64>(static_cast<u8>(key[i]));
+        };
+
+        const auto len = key.size();
+        return static_cast<u64>(len) | at(skip_) << 8 | at(skip_ + 1) << 16 | at(len - 2) << 24 |
+               at(len - 1) << 32;
+    }
+
+    // A seeded multiply-xorshift mix, keeping the well distributed high bits.
+    [[nodiscard]] constexpr auto hash(std::string_view key) const noexcept -> usize {
+        auto x = (sample(key) ^ seed_) * 0x9E3779B97F4A7C15u;
+        x ^= x >> 29;
+        x *= 0xBF58476D1CE4E5B9u;
+        return static_cast<usize>(x >> (64 - TABLE_BITS));
+    }
+
+    constexpr auto try_seed() -> bool {
+        slots_.fill(0);
+        for (usize i = 0; i < N; ++i) {
+            auto& slot = slots_[hash(entries_[i].first)];
+            if (slot != 0) { return false; }
+            slot = static_cast<u8>(i + 1);
+        }
+        return true;
+    }
+
+  private:
+    std::array<Entry, N>       entries_;
+    std::array<u8, TABLE_SIZE> slots_{};
+    usize                      min_len_{0};
+    usize                      max_len_{0};
+    usize                      skip_{0};
+    u64                        seed_{0};
+};
+
+} // namespace conch
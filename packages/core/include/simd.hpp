@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string_view>
+
+#include "types.hpp"
+
+namespace conch::simd {
+
+// The instruction sets the bulk scanners can dispatch to, ordered from least to most capable.
+enum class Isa : u8 {
+    SCALAR,
+    SSE2,
+    AVX2,
+};
+
+// Returns the widest instruction set supported by the running CPU, cached after the first call.
+[[nodiscard]] auto detect_isa() noexcept -> Isa;
+
+// Returns the index of the first byte at or after `from` that is not ASCII whitespace, or the
+// size of the input if the remainder is entirely whitespace.
+//
+// Whitespace matches the classic C locale: space, tab, newline, vertical tab, form feed and CR.
+[[nodiscard]] auto skip_whitespace(std::string_view input,
+                                   usize            from,
+                                   Isa              isa = detect_isa()) noexcept -> usize;
+
+// Returns the index of the first byte at or after `from` equal to either `a` or `b`, or the size
+// of the input if neither is present.
+[[nodiscard]] auto find_either(std::string_view input,
+                               usize            from,
+                               byte             a,
+                               byte             b,
+                               Isa              isa = detect_isa()) noexcept -> usize;
+
+// Returns the index of the first occurrence of `needle` at or after `from`, or the input size.
+[[nodiscard]] inline auto find(std::string_view input,
+                               usize            from,
+                               byte             needle,
+                               Isa              isa = detect_isa()) noexcept -> usize {
+    return find_either(input, from, needle, needle, isa);
+}
+
+// Counts the occurrences of `needle` in the input.
+[[nodiscard]] auto count(std::string_view input, byte needle, Isa isa = detect_isa()) noexcept
+    -> usize;
+
+} // namespace conch::simd
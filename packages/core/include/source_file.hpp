@@ -0,0 +1,62 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "diagnostic.hpp"
+#include "expected.hpp"
+#include "memory.hpp"
+#include "source_limits.hpp"
+#include "types.hpp"
+
+namespace conch {
+
+enum class FileError : u8 {
+    OPEN_FAILED,
+    READ_FAILED,
+    INVALID_UTF8,
+    TOO_LARGE,
+};
+
+// The read-only contents of a source file.
+//
+// Regular files are memory mapped and read sequentially by the kernel, while pipes and other
+// unmappable files fall back to a buffered read. Either way the contents never move, so views into
+// them stay valid across moves for as long as the file object is alive. Contents are validated as
+// UTF-8 on open, with the first malformed byte reported as the diagnostic's location.
+class SourceFile {
+  public:
+    // Files are rejected past the largest source that tokens can address.
+    static constexpr usize MAX_SIZE = MAX_SOURCE_SIZE;
+
+  public:
+    SourceFile() noexcept = default;
+    ~SourceFile();
+
+    SourceFile(const SourceFile&)                    = delete;
+    auto operator=(const SourceFile&) -> SourceFile& = delete;
+    SourceFile(SourceFile&& other) noexcept;
+    auto operator=(SourceFile&& other) noexcept -> SourceFile&;
+
+    [[nodiscard]] static auto open(const std::filesystem::path& path)
+        -> Expected<SourceFile, Diagnostic<FileError>>;
+
+    [[nodiscard]] auto view() const noexcept -> std::string_view { return {data_, size_}; }
+    [[nodiscard]] auto size() const noexcept -> usize { return size_; }
+    [[nodiscard]] auto is_mapped() const noexcept -> bool { return mapped_; }
+
+  private:
+    [[nodiscard]] static auto map(const std::filesystem::path& path)
+        -> Expected<SourceFile, Diagnostic<FileError>>;
+    [[nodiscard]] static auto buffered(Box<std::string> contents) noexcept -> SourceFile;
+    auto release() noexcept -> void;
+
+  private:
+    const byte*      data_{nullptr};
+    usize            size_{0};
+    bool             mapped_{false};
+    Box<std::string> buffer_;
+};
+
+} // namespace conch
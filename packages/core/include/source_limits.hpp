@@ -0,0 +1,12 @@
+#pragma once
+
+#include <limits>
+
+#include "types.hpp"
+
+namespace conch {
+
+// Tokens address their source with 32 bit offsets, so sources of 4 GiB or more are rejected.
+inline constexpr usize MAX_SOURCE_SIZE = std::numeric_limits<u32>::max();
+
+} // namespace conch
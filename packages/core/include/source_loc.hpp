@@ -19,6 +19,10 @@ struct SourceLocation {
 
 template <typename T> struct SourceInfo;
 
+template <> struct SourceInfo<SourceLocation> {
+    static auto get(const SourceLocation& loc) -> SourceLocation { return loc; }
+};
+
 template <typename T>
 concept Locateable = requires(T t) {
     { SourceInfo<T>::get(t) } -> std::same_as<SourceLocation>;
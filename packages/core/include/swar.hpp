@@ -0,0 +1,59 @@
+#pragma once
+
+#include <bit>
+#include <cstring>
+
+#include "optional.hpp"
+#include "types.hpp"
+
+// Helpers for processing eight bytes at a time packed into a single 64-bit word.
+namespace conch::swar {
+
+constexpr u64 ONES = 0x0101010101010101;
+constexpr u64 HIGH = 0x8080808080808080;
+
+// Loads eight bytes so that the first byte occupies the least significant lane.
+[[nodiscard]] inline auto load(const byte* bytes) noexcept -> u64 {
+    u64 word;
+    std::memcpy(&word, bytes, sizeof(word));
+    if constexpr (std::endian::native == std::endian::big) { word = std::byteswap(word); }
+    return word;
+}
+
+// Sets the high bit of every lane whose byte lies in [lo, hi], assuming every byte is ASCII.
+[[nodiscard]] constexpr auto in_range(u64 word, u8 lo, u8 hi) noexcept -> u64 {
+    return (word + ONES * (0x80 - lo)) & ~(word + ONES * (0x7F - hi)) & HIGH;
+}
+
+// Decodes eight ASCII decimal digits, or returns nullopt if any byte is not a digit.
+[[nodiscard]] inline auto parse_eight_decimal(const byte* digits) noexcept -> Optional<u32> {
+    auto word = load(digits);
+    if ((word & HIGH) != 0 || in_range(word, '0', '9') != HIGH) { return nullopt; }
+
+    // Fold adjacent lanes together, doubling the digits held per lane at each step
+    word -= ONES * '0';
+    word = (word * 10) + (word >> 8);
+    word = (((word & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) +
+            (((word >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >>
+           32;
+    return static_cast<u32>(word);
+}
+
+// Decodes eight ASCII hex digits of either case, or returns nullopt if any byte is not a digit.
+[[nodiscard]] inline auto parse_eight_hex(const byte* digits) noexcept -> Optional<u32> {
+    const auto word = load(digits);
+    if ((word & HIGH) != 0) { return nullopt; }
+
+    const auto lower   = word | (ONES * 0x20);
+    const auto letters = in_range(lower, 'a', 'f');
+    if ((in_range(word, '0', '9') | letters) != HIGH) { return nullopt; }
+
+    // Pack the nibbles together, with the first digit ending up most significant
+    auto packed = (lower & (ONES * 0x0F)) + (letters >> 7) * 9;
+    packed      = ((packed & 0x000F000F000F000F) << 4) | ((packed & 0x0F000F000F000F00) >> 8);
+    packed      = ((packed & 0x000000FF000000FF) << 8) | ((packed & 0x00FF000000FF0000) >> 16);
+    packed      = ((packed & 0x000000000000FFFF) << 16) | ((packed & 0x0000FFFF00000000) >> 32);
+    return static_cast<u32>(packed);
+}
+
+} // namespace conch::swar
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string_view>
+
+#include "optional.hpp"
+#include "simd.hpp"
+#include "types.hpp"
+
+namespace conch::unicode {
+
+struct CodePoint {
+    char32_t value;
+    u8       length;
+};
+
+[[nodiscard]] constexpr auto is_ascii(byte b) noexcept -> bool { return static_cast<u8>(b) < 0x80; }
+
+// Decodes the well-formed UTF-8 sequence starting at the offset, rejecting overlong encodings,
+// surrogates and code points past U+10FFFF.
+[[nodiscard]] auto decode(std::string_view input, usize offset) noexcept -> Optional<CodePoint>;
+
+// Returns the offset of the first byte that is not part of a well-formed UTF-8 sequence, or
+// nullopt if the whole input is valid. Pure ASCII runs are skipped a vector at a time.
+[[nodiscard]] auto find_invalid_utf8(std::string_view input,
+                                     simd::Isa        isa = simd::detect_isa()) noexcept
+    -> Optional<usize>;
+
+// Membership in the XID_Start and XID_Continue properties that Unicode recommends for identifiers.
+[[nodiscard]] auto is_xid_start(char32_t cp) noexcept -> bool;
+[[nodiscard]] auto is_xid_continue(char32_t cp) noexcept -> bool;
+
+} // namespace conch::unicode
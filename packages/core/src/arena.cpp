@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <new>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "arena.hpp"
+
+namespace conch {
+
+#if defined(_WIN32)
+
+static auto map_chunk(usize size) -> void* {
+    const auto data = ::VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (data == nullptr) { throw std::bad_alloc{}; }
+    return data;
+}
+
+static auto unmap_chunk(void* data, [[maybe_unused]] usize size) noexcept -> void {
+    ::VirtualFree(data, 0, MEM_RELEASE);
+}
+
+#else
+
+static auto map_chunk(usize size) -> void* {
+    const auto data =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED) { throw std::bad_alloc{}; }
+    return data;
+}
+
+static auto unmap_chunk(void* data, usize size) noexcept -> void { ::munmap(data, size); }
+
+#endif
+
+Arena::~Arena() { release(); }
+
+Arena::Arena(Arena&& other) noexcept
+    : chunks_{std::move(other.chunks_)}, cursor_{std::exchange(other.cursor_, 0)},
+      limit_{std::exchange(other.limit_, 0)}, used_{std::exchange(other.used_, 0)},
+      next_chunk_size_{std::exchange(other.next_chunk_size_, DEFAULT_CHUNK_SIZE)} {
+    other.chunks_.clear();
+}
+
+auto Arena::operator=(Arena&& other) noexcept -> Arena& {
+    if (this != &other) {
+        release();
+        chunks_          = std::move(other.chunks_);
+        cursor_          = std::exchange(other.cursor_, 0);
+        limit_           = std::exchange(other.limit_, 0);
+        used_            = std::exchange(other.used_, 0);
+        next_chunk_size_ = std::exchange(other.next_chunk_size_, DEFAULT_CHUNK_SIZE);
+        other.chunks_.clear();
+    }
+    return *this;
+}
+
+auto Arena::release() noexcept -> void {
+    for (const auto& chunk : chunks_) { unmap_chunk(chunk.data, chunk.size); }
+    chunks_.clear();
+    cursor_ = 0;
+    limit_  = 0;
+    used_   = 0;
+}
+
+auto Arena::allocate_slow(usize size, usize alignment) -> void* {
+    // Oversized requests get a chunk of their own instead of stalling the growth schedule
+    const auto chunk_size = std::max(next_chunk_size_, size + alignment);
+    chunks_.reserve(chunks_.size() + 1);
+    const auto data = map_chunk(chunk_size);
+    chunks_.push_back({data, chunk_size});
+
+    cursor_          = reinterpret_cast<std::uintptr_t>(data);
+    limit_           = cursor_ + chunk_size;
+    next_chunk_size_ = std::min(next_chunk_size_ * 2, MAX_CHUNK_SIZE);
+    return allocate(size, alignment);
+}
+
+} // namespace conch
@@ -1,10 +1,21 @@
 #include <sstream>
 
+#include <fmt/args.h>
 #include <fmt/format.h>
 
 #include "diagnostic.hpp"
 
-namespace conch::detail {
+namespace conch {
+
+auto DiagnosticMessage::render() const -> std::string {
+    fmt::dynamic_format_arg_store<fmt::format_context> store;
+    for (usize i = 0; i < arg_count_; ++i) {
+        std::visit([&](const auto& arg) { store.push_back(arg); }, args_[i]);
+    }
+    return fmt::vformat(format_, store);
+}
+
+namespace detail {
 
 auto format_diagnostic(const std::optional<std::string>&    message,
                        std::string_view                     error_name,
@@ -17,4 +28,6 @@ auto format_diagnostic(const std::optional<std::string>&    message,
     return ss.str();
 }
 
-} // namespace conch::detail
+} // namespace detail
+
+} // namespace conch
@@ -0,0 +1,31 @@
+#include <algorithm>
+#include <cassert>
+
+#include "line_index.hpp"
+#include "simd.hpp"
+#include "source_limits.hpp"
+
+namespace conch {
+
+// Offsets come from u32 token offsets, which only cover sources up to the size limit.
+LineIndex::LineIndex(std::string_view source) : source_{source} {
+    assert(source.size() <= MAX_SOURCE_SIZE);
+    line_starts_.reserve(simd::count(source, '\n') + 1);
+    auto pos = simd::find(source, 0, '\n');
+    while (pos < source.size()) {
+        line_starts_.push_back(pos + 1);
+        pos = simd::find(source, pos + 1, '\n');
+    }
+}
+
+auto LineIndex::locate(usize offset) const noexcept -> SourceLocation {
+    if (offset < source_.size() && source_[offset] == '\n') {
+        const auto next_line = std::ranges::lower_bound(line_starts_, offset + 1);
+        return {static_cast<usize>(next_line - line_starts_.begin()) + 1, 0};
+    }
+
+    const auto line = std::ranges::upper_bound(line_starts_, offset) - line_starts_.begin();
+    return {static_cast<usize>(line), offset - line_starts_[static_cast<usize>(line) - 1] + 1};
+}
+
+} // namespace conch
@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <bit>
+
+#if defined(__x86_64__)
+#define CONCH_SIMD_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#include "simd.hpp"
+#include "types.hpp"
+
+namespace conch::simd {
+
+namespace {
+
+constexpr auto is_whitespace(byte b) noexcept -> bool {
+    return b == ' ' || static_cast<u8>(static_cast<u8>(b) - u8{'\t'}) <= u8{'\r' - '\t'};
+}
+
+auto skip_whitespace_scalar(std::string_view input, usize from) noexcept -> usize {
+    while (from < input.size() && is_whitespace(input[from])) { ++from; }
+    return from;
+}
+
+auto find_either_scalar(std::string_view input, usize from, byte a, byte b) noexcept -> usize {
+    while (from < input.size() && input[from] != a && input[from] != b) { ++from; }
+    return from;
+}
+
+auto count_scalar(std::string_view input, byte needle) noexcept -> usize {
+    return static_cast<usize>(std::ranges::count(input, needle));
+}
+
+#ifdef CONCH_SIMD_X86
+
+auto detect_isa_uncached() noexcept -> Isa {
+    u32 eax{}, ebx{}, ecx{}, edx{};
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) { return Isa::SSE2; }
+    if ((ecx & bit_OSXSAVE) == 0 || (ecx & bit_AVX) == 0) { return Isa::SSE2; }
+
+    // The OS must also save the upper halves of the ymm registers across context switches
+    u32 xcr0_lo{}, xcr0_hi{};
+    __asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    if ((xcr0_lo & 0x6) != 0x6) { return Isa::SSE2; }
+
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) == 0) { return Isa::SSE2; }
+    return (ebx & bit_AVX2) != 0 ? Isa::AVX2 : Isa::SSE2;
+}
+
+auto whitespace_mask_sse2(__m128i chunk) noexcept -> u32 {
+    const auto spaces   = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' '));
+    const auto shifted  = _mm_sub_epi8(chunk, _mm_set1_epi8('\t'));
+    const auto limit    = _mm_set1_epi8('\r' - '\t');
+    const auto controls = _mm_cmpeq_epi8(_mm_min_epu8(shifted, limit), shifted);
+    return static_cast<u32>(_mm_movemask_epi8(_mm_or_si128(spaces, controls)));
+}
+
+auto skip_whitespace_sse2(std::string_view input, usize from) noexcept -> usize {
+    constexpr usize WIDTH = 16;
+    for (; from + WIDTH <= input.size(); from += WIDTH) {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + from));
+        const auto mask  = ~whitespace_mask_sse2(chunk) & 0xFFFFu;
+        if (mask != 0) { return from + static_cast<usize>(std::countr_zero(mask)); }
+    }
+    return skip_whitespace_scalar(input, from);
+}
+
+auto find_either_sse2(std::string_view input, usize from, byte a, byte b) noexcept -> usize {
+    constexpr usize WIDTH = 16;
+    const auto      va    = _mm_set1_epi8(a);
+    const auto      vb    = _mm_set1_epi8(b);
+    for (; from + WIDTH <= input.size(); from += WIDTH) {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + from));
+        const auto hits  = _mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb));
+        const auto mask  = static_cast<u32>(_mm_movemask_epi8(hits));
+        if (mask != 0) { return from + static_cast<usize>(std::countr_zero(mask)); }
+    }
+    return find_either_scalar(input, from, a, b);
+}
+
+auto count_sse2(std::string_view input, byte needle) noexcept -> usize {
+    constexpr usize WIDTH = 16;
+    const auto      vn    = _mm_set1_epi8(needle);
+    usize           total = 0;
+    usize           i     = 0;
+    for (; i + WIDTH <= input.size(); i += WIDTH) {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + i));
+        const auto mask  = static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, vn)));
+        total += static_cast<usize>(std::popcount(mask));
+    }
+    return total + count_scalar(input.substr(i), needle);
+}
+
+__attribute__((target("avx2"))) auto whitespace_mask_avx2(__m256i chunk) noexcept -> u32 {
+    const auto spaces   = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' '));
+    const auto shifted  = _mm256_sub_epi8(chunk, _mm256_set1_epi8('\t'));
+    const auto limit    = _mm256_set1_epi8('\r' - '\t');
+    const auto controls = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, limit), shifted);
+    return static_cast<u32>(_mm256_movemask_epi8(_mm256_or_si256(spaces, controls)));
+}
+
+__attribute__((target("avx2"))) auto skip_whitespace_avx2(std::string_view input,
+                                                          usize from) noexcept -> usize {
+    constexpr usize WIDTH = 32;
+    for (; from + WIDTH <= input.size(); from += WIDTH) {
+        const auto chunk =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.data() + from));
+        const auto mask = ~whitespace_mask_avx2(chunk);
+        if (mask != 0) { return from + static_cast<usize>(std::countr_zero(mask)); }
+    }
+    return skip_whitespace_sse2(input, from);
+}
+
+__attribute__((target("avx2"))) auto
+find_either_avx2(std::string_view input, usize from, byte a, byte b) noexcept -> usize {
+    constexpr usize WIDTH = 32;
+    const auto      va    = _mm256_set1_epi8(a);
+    const auto      vb    = _mm256_set1_epi8(b);
+    for (; from + WIDTH <= input.size(); from += WIDTH) {
+        const auto chunk =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.data() + from));
+        const auto hits =
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, va), _mm256_cmpeq_epi8(chunk, vb));
+        const auto mask = static_cast<u32>(_mm256_movemask_epi8(hits));
+        if (mask != 0) { return from + static_cast<usize>(std::countr_zero(mask)); }
+    }
+    return find_either_sse2(input, from, a, b);
+}
+
+__attribute__((target("avx2"))) auto count_avx2(std::string_view input, byte needle) noexcept
+    -> usize {
+    constexpr usize WIDTH = 32;
+    const auto      vn    = _mm256_set1_epi8(needle);
+    usize           total = 0;
+    usize           i     = 0;
+    for (; i + WIDTH <= input.size(); i += WIDTH) {
+        const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.data() + i));
+        const auto mask  = static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, vn)));
+        total += static_cast<usize>(std::popcount(mask));
+    }
+    return total + count_sse2(input.substr(i), needle);
+}
+
+#endif
+
+} // namespace
+
+auto detect_isa() noexcept -> Isa {
+#ifdef CONCH_SIMD_X86
+    static const auto isa = detect_isa_uncached();
+    return isa;
+#else
+    return Isa::SCALAR;
+#endif
+}
+
+auto skip_whitespace(std::string_view input, usize from, [[maybe_unused]] Isa isa) noexcept
+    -> usize {
+    if (from >= input.size()) { return input.size(); }
+#ifdef CONCH_SIMD_X86
+    switch (isa) {
+    case Isa::AVX2: return skip_whitespace_avx2(input, from);
+    case Isa::SSE2: return skip_whitespace_sse2(input, from);
+    default:        break;
+    }
+#endif
+    return skip_whitespace_scalar(input, from);
+}
+
+auto find_either(std::string_view input, usize from, byte a, byte b, [[maybe_unused]] Isa isa) noexcept
+    -> usize {
+    if (from >= input.size()) { return input.size(); }
+#ifdef CONCH_SIMD_X86
+    switch (isa) {
+    case Isa::AVX2: return find_either_avx2(input, from, a, b);
+    case Isa::SSE2: return find_either_sse2(input, from, a, b);
+    default:        break;
+    }
+#endif
+    return find_either_scalar(input, from, a, b);
+}
+
+auto count(std::string_view input, byte needle, [[maybe_unused]] Isa isa) noexcept -> usize {
+#ifdef CONCH_SIMD_X86
+    switch (isa) {
+    case Isa::AVX2: return count_avx2(input, needle);
+    case Isa::SSE2: return count_sse2(input, needle);
+    default:        break;
+    }
+#endif
+    return count_scalar(input, needle);
+}
+
+} // namespace conch::simd
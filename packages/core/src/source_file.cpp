@@ -0,0 +1,192 @@
+#include <array>
+#include <cerrno>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <fmt/format.h>
+
+#include "line_index.hpp"
+#include "source_file.hpp"
+#include "unicode.hpp"
+
+namespace conch {
+
+static auto file_error(std::string_view what, const std::filesystem::path& path, FileError err)
+    -> Unexpected<Diagnostic<FileError>> {
+    auto message = fmt::format("Failed to {} '{}'", what, path.string());
+    return Unexpected{Diagnostic<FileError>{std::move(message), err}};
+}
+
+SourceFile::~SourceFile() { release(); }
+
+auto SourceFile::open(const std::filesystem::path& path)
+    -> Expected<SourceFile, Diagnostic<FileError>> {
+    auto file = TRY(map(path));
+    if (file.size() > MAX_SIZE) {
+        auto message = fmt::format(
+            "'{}' is {} bytes, over the {} byte limit", path.string(), file.size(), MAX_SIZE);
+        return Unexpected{Diagnostic<FileError>{std::move(message), FileError::TOO_LARGE}};
+    }
+
+    // Validating once here lets the lexer decode non-ASCII input without re-checking it
+    const auto source = file.view();
+    if (const auto invalid = unicode::find_invalid_utf8(source)) {
+        const auto loc     = LineIndex{source}.locate(*invalid);
+        auto       message = fmt::format("Invalid UTF-8 in '{}'", path.string());
+        return Unexpected{Diagnostic<FileError>{
+            std::move(message), FileError::INVALID_UTF8, loc.line, loc.column}};
+    }
+    return file;
+}
+
+SourceFile::SourceFile(SourceFile&& other) noexcept
+    : data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)},
+      mapped_{std::exchange(other.mapped_, false)}, buffer_{std::move(other.buffer_)} {}
+
+auto SourceFile::operator=(SourceFile&& other) noexcept -> SourceFile& {
+    if (this != &other) {
+        release();
+        data_   = std::exchange(other.data_, nullptr);
+        size_   = std::exchange(other.size_, 0);
+        mapped_ = std::exchange(other.mapped_, false);
+        buffer_ = std::move(other.buffer_);
+    }
+    return *this;
+}
+
+#if defined(_WIN32)
+
+auto SourceFile::map(const std::filesystem::path& path)
+    -> Expected<SourceFile, Diagnostic<FileError>> {
+    const auto handle = ::CreateFileW(path.c_str(),
+                                      GENERIC_READ,
+                                      FILE_SHARE_READ,
+                                      nullptr,
+                                      OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                      nullptr);
+    if (handle == INVALID_HANDLE_VALUE) { return file_error("open", path, FileError::OPEN_FAILED); }
+
+    // Reads whatever the open handle has left, so pipes and devices are only opened once
+    const auto read_handle = [&]() -> Expected<SourceFile, Diagnostic<FileError>> {
+        auto                             contents = make_box<std::string>();
+        std::array<byte, usize{1} << 16> chunk{};
+        const auto                       capacity = static_cast<DWORD>(chunk.size());
+        DWORD                            read     = 0;
+        BOOL                             ok       = FALSE;
+        while ((ok = ::ReadFile(handle, chunk.data(), capacity, &read, nullptr)) && read > 0) {
+            contents->append(chunk.data(), read);
+        }
+
+        // Pipes report a closed writer as an error rather than as the end of the file
+        const auto error = ok ? ERROR_SUCCESS : ::GetLastError();
+        ::CloseHandle(handle);
+        if (error != ERROR_SUCCESS && error != ERROR_BROKEN_PIPE) {
+            return file_error("read", path, FileError::READ_FAILED);
+        }
+        return buffered(std::move(contents));
+    };
+
+    LARGE_INTEGER size{};
+    if (::GetFileType(handle) != FILE_TYPE_DISK || !::GetFileSizeEx(handle, &size)) {
+        return read_handle();
+    }
+
+    if (size.QuadPart == 0) {
+        ::CloseHandle(handle);
+        return SourceFile{};
+    }
+
+    // The view keeps the mapping object alive, so neither handle is needed once it exists
+    const auto mapping = ::CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) { return read_handle(); }
+
+    const auto view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(mapping);
+    if (view == nullptr) { return read_handle(); }
+    ::CloseHandle(handle);
+
+    SourceFile file;
+    file.data_   = static_cast<const byte*>(view);
+    file.size_   = static_cast<usize>(size.QuadPart);
+    file.mapped_ = true;
+    return file;
+}
+
+auto SourceFile::release() noexcept -> void {
+    if (mapped_) { ::UnmapViewOfFile(data_); }
+}
+
+#else
+
+auto SourceFile::map(const std::filesystem::path& path)
+    -> Expected<SourceFile, Diagnostic<FileError>> {
+    const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) { return file_error("open", path, FileError::OPEN_FAILED); }
+
+    // Reads whatever the open descriptor has left, so pipes and devices are only opened once
+    const auto read_descriptor = [&]() -> Expected<SourceFile, Diagnostic<FileError>> {
+        auto                             contents = make_box<std::string>();
+        std::array<byte, usize{1} << 16> chunk{};
+        while (true) {
+            const auto read = ::read(fd, chunk.data(), chunk.size());
+            if (read == 0) { break; }
+            if (read < 0) {
+                if (errno == EINTR) { continue; }
+                ::close(fd);
+                return file_error("read", path, FileError::READ_FAILED);
+            }
+            contents->append(chunk.data(), static_cast<usize>(read));
+        }
+        ::close(fd);
+        return buffered(std::move(contents));
+    };
+
+    // Pipes, sockets and devices cannot be mapped
+    struct stat info{};
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) { return read_descriptor(); }
+
+    const auto size = static_cast<usize>(info.st_size);
+    if (size == 0) {
+        ::close(fd);
+        return SourceFile{};
+    }
+
+    // The mapping holds its own reference to the file, so the descriptor can go once it exists
+    const auto mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) { return read_descriptor(); }
+    ::close(fd);
+    ::posix_madvise(mapping, size, POSIX_MADV_SEQUENTIAL);
+
+    SourceFile file;
+    file.data_   = static_cast<const byte*>(mapping);
+    file.size_   = size;
+    file.mapped_ = true;
+    return file;
+}
+
+auto SourceFile::release() noexcept -> void {
+    if (mapped_) { ::munmap(const_cast<byte*>(data_), size_); }
+}
+
+#endif
+
+auto SourceFile::buffered(Box<std::string> contents) noexcept -> SourceFile {
+    SourceFile file;
+    file.data_   = contents->data();
+    file.size_   = contents->size();
+    file.buffer_ = std::move(contents);
+    return file;
+}
+
+} // namespace conch
@@ -0,0 +1,297 @@
+#include <array>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__)
+#define CONCH_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#include "unicode.hpp"
+
+namespace conch::unicode {
+
+namespace {
+
+constexpr auto is_continuation(byte b) noexcept -> bool {
+    return (static_cast<u8>(b) & 0xC0) == 0x80;
+}
+
+// Validates sequence by sequence from a character boundary.
+auto find_invalid_scalar(std::string_view input, usize from) noexcept -> Optional<usize> {
+    while (from < input.size()) {
+        if (is_ascii(input[from])) {
+            from += 1;
+            continue;
+        }
+
+        const auto cp = decode(input, from);
+        if (!cp) { return from; }
+        from += cp->length;
+    }
+    return nullopt;
+}
+
+#ifdef CONCH_SIMD_X86
+
+auto find_invalid_sse2(std::string_view input) noexcept -> Optional<usize> {
+    constexpr usize WIDTH = 16;
+
+    usize from = 0;
+    while (from + WIDTH <= input.size()) {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + from));
+        const auto mask  = static_cast<u32>(_mm_movemask_epi8(chunk));
+        if (mask == 0) {
+            from += WIDTH;
+            continue;
+        }
+
+        // Decode through the non-ASCII bytes of this vector, ending on a character boundary
+        const auto end = from + WIDTH;
+        from += static_cast<usize>(std::countr_zero(mask));
+        while (from < end) {
+            const auto cp = decode(input, from);
+            if (!cp) { return from; }
+            from += cp->length;
+        }
+    }
+    return find_invalid_scalar(input, from);
+}
+
+// The lookup algorithm from "Validating UTF-8 In Less Than One Instruction Per Byte" by Keiser
+// and Lemire. Each byte is classified by the nibbles of itself and the byte before it, and the
+// error classes of all three lookups must agree for a pair to be invalid.
+constexpr u8 TOO_SHORT      = 1 << 0;
+constexpr u8 TOO_LONG       = 1 << 1;
+constexpr u8 OVERLONG_3     = 1 << 2;
+constexpr u8 TOO_LARGE      = 1 << 3;
+constexpr u8 SURROGATE      = 1 << 4;
+constexpr u8 OVERLONG_2     = 1 << 5;
+constexpr u8 TOO_LARGE_1000 = 1 << 6;
+constexpr u8 OVERLONG_4     = 1 << 6;
+constexpr u8 TWO_CONTS      = 1 << 7;
+constexpr u8 CARRY          = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+constexpr std::array<u8, 16> BYTE_1_HIGH{
+    TOO_LONG,
+    TOO_LONG,
+    TOO_LONG,
+    TOO_LONG,
+    TOO_LONG,
+    TOO_LONG,
+    TOO_LONG,
+    TOO_LONG,
+    TWO_CONTS,
+    TWO_CONTS,
+    TWO_CONTS,
+    TWO_CONTS,
+    TOO_SHORT | OVERLONG_2,
+    TOO_SHORT,
+    TOO_SHORT | OVERLONG_3 | SURROGATE,
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,
+};
+
+constexpr std::array<u8, 16> BYTE_1_LOW{
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+    CARRY | OVERLONG_2,
+    CARRY,
+    CARRY,
+    CARRY | TOO_LARGE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+};
+
+constexpr std::array<u8, 16> BYTE_2_HIGH{
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_SHORT,
+    TOO_SHORT,
+};
+
+// A block ending in any of these bytes still expects continuation bytes in the next block.
+constexpr auto INCOMPLETE_LIMITS = []() {
+    std::array<u8, 32> limits{};
+    limits.fill(0xFF);
+    limits[29] = 0xF0 - 1;
+    limits[30] = 0xE0 - 1;
+    limits[31] = 0xC0 - 1;
+    return limits;
+}();
+
+__attribute__((target("avx2"))) auto broadcast_table(const std::array<u8, 16>& table) noexcept
+    -> __m256i {
+    return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(
+        table.data())));
+}
+
+// Shifts the block right by N bytes, pulling in the tail of the previous block.
+template <int N>
+__attribute__((target("avx2"))) auto previous_bytes(__m256i input, __m256i prev_input) noexcept
+    -> __m256i {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev_input, input, 0x21), 16 - N);
+}
+
+__attribute__((target("avx2"))) auto block_errors(__m256i input, __m256i prev_input) noexcept
+    -> __m256i {
+    const auto low_nibble = _mm256_set1_epi8(0x0F);
+    const auto prev1      = previous_bytes<1>(input, prev_input);
+
+    const auto byte_1_high = _mm256_shuffle_epi8(
+        broadcast_table(BYTE_1_HIGH), _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble));
+    const auto byte_1_low =
+        _mm256_shuffle_epi8(broadcast_table(BYTE_1_LOW), _mm256_and_si256(prev1, low_nibble));
+    const auto byte_2_high = _mm256_shuffle_epi8(
+        broadcast_table(BYTE_2_HIGH), _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble));
+    const auto special_cases =
+        _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+    // Third and fourth bytes of a sequence must be continuations, which cancels TWO_CONTS
+    const auto prev2     = previous_bytes<2>(input, prev_input);
+    const auto prev3     = previous_bytes<3>(input, prev_input);
+    const auto is_third  = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80));
+    const auto is_fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80));
+    const auto must_continue = _mm256_and_si256(_mm256_or_si256(is_third, is_fourth),
+                                                _mm256_set1_epi8(static_cast<byte>(0x80)));
+    return _mm256_xor_si256(must_continue, special_cases);
+}
+
+// The tail of the last non-ASCII block, which the next block continues.
+struct BlockCarry {
+    __m256i prev_input;
+    __m256i prev_incomplete;
+};
+
+// Returns true if the block is valid given what the previous blocks carried into it.
+__attribute__((target("avx2"))) auto check_block(__m256i block, BlockCarry& carry) noexcept
+    -> bool {
+    __m256i error;
+    if (_mm256_movemask_epi8(block) == 0) {
+        error = carry.prev_incomplete;
+    } else {
+        const auto limits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+            INCOMPLETE_LIMITS.data()));
+        error                 = block_errors(block, carry.prev_input);
+        carry.prev_incomplete = _mm256_subs_epu8(block, limits);
+        carry.prev_input      = block;
+    }
+    return _mm256_testz_si256(error, error) != 0;
+}
+
+// Returns the offset of the block containing the first error, which is the input size when the
+// input ends in an incomplete sequence.
+__attribute__((target("avx2"))) auto first_invalid_block_avx2(std::string_view input) noexcept
+    -> Optional<usize> {
+    constexpr usize WIDTH = 32;
+
+    BlockCarry carry{_mm256_setzero_si256(), _mm256_setzero_si256()};
+    usize      from = 0;
+    for (; from + WIDTH <= input.size(); from += WIDTH) {
+        const auto block =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.data() + from));
+        if (!check_block(block, carry)) { return from; }
+    }
+
+    // The zero padding after the tail is ASCII, so it also flushes any incomplete sequence
+    std::array<byte, WIDTH> tail{};
+    if (from < input.size()) { std::memcpy(tail.data(), input.data() + from, input.size() - from); }
+    if (!check_block(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(tail.data())), carry) ||
+        !check_block(_mm256_setzero_si256(), carry)) {
+        return from;
+    }
+    return nullopt;
+}
+
+auto find_invalid_avx2(std::string_view input) noexcept -> Optional<usize> {
+    const auto block = first_invalid_block_avx2(input);
+    if (!block) { return nullopt; }
+
+    // An error may stem from a sequence the previous block left incomplete, so pinpoint it by
+    // decoding from the last character boundary at least four bytes before the block
+    usize from = 0;
+    if (*block >= 4) {
+        from = *block - 4;
+        while (is_continuation(input[from])) { from += 1; }
+    }
+    return find_invalid_scalar(input, from);
+}
+
+#endif
+
+} // namespace
+
+auto decode(std::string_view input, usize offset) noexcept -> Optional<CodePoint> {
+    if (offset >= input.size()) { return nullopt; }
+
+    const auto lead = static_cast<u8>(input[offset]);
+    if (lead < 0x80) { return CodePoint{lead, 1}; }
+
+    // The valid range of the second byte depends on the lead, which rules out overlong encodings,
+    // surrogates and values past U+10FFFF
+    u8       length;
+    char32_t value;
+    u8       second_lo = 0x80;
+    u8       second_hi = 0xBF;
+    if (lead < 0xC2) {
+        return nullopt;
+    } else if (lead < 0xE0) {
+        length = 2;
+        value  = lead & 0x1F;
+    } else if (lead < 0xF0) {
+        length = 3;
+        value  = lead & 0x0F;
+        if (lead == 0xE0) { second_lo = 0xA0; }
+        if (lead == 0xED) { second_hi = 0x9F; }
+    } else if (lead < 0xF5) {
+        length = 4;
+        value  = lead & 0x07;
+        if (lead == 0xF0) { second_lo = 0x90; }
+        if (lead == 0xF4) { second_hi = 0x8F; }
+    } else {
+        return nullopt;
+    }
+
+    if (offset + length > input.size()) { return nullopt; }
+    for (u8 i = 1; i < length; ++i) {
+        const auto b = static_cast<u8>(input[offset + i]);
+        if (i == 1 ? (b < second_lo || b > second_hi) : !is_continuation(static_cast<byte>(b))) {
+            return nullopt;
+        }
+        value = (value << 6) | (b & 0x3F);
+    }
+    return CodePoint{value, length};
+}
+
+auto find_invalid_utf8(std::string_view input, [[maybe_unused]] simd::Isa isa) noexcept
+    -> Optional<usize> {
+#ifdef CONCH_SIMD_X86
+    switch (isa) {
+    case simd::Isa::AVX2: return find_invalid_avx2(input);
+    case simd::Isa::SSE2: return find_invalid_sse2(input);
+    default:              break;
+    }
+#endif
+    return find_invalid_scalar(input, 0);
+}
+
+} // namespace conch::unicode
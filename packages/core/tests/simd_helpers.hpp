@@ -0,0 +1,21 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "simd.hpp"
+
+namespace conch::tests::helpers {
+
+// Every instruction set up to and including the one the host supports
+inline auto supported_isas() -> std::vector<simd::Isa> {
+    std::vector<simd::Isa> isas;
+    for (auto isa : {simd::Isa::SCALAR, simd::Isa::SSE2, simd::Isa::AVX2}) {
+        if (std::to_underlying(isa) <= std::to_underlying(simd::detect_isa())) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+} // namespace conch::tests::helpers
@@ -0,0 +1,60 @@
+#include <cstdint>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "arena.hpp"
+#include "memory.hpp"
+
+namespace conch::tests {
+
+TEST_CASE("Arena allocation") {
+    Arena arena{256};
+    REQUIRE(arena.chunk_count() == 0);
+
+    const auto* a = static_cast<const byte*>(arena.allocate(3, 1));
+    const auto* b = arena.allocate(8, 8);
+    REQUIRE(arena.chunk_count() == 1);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(b) % 8 == 0);
+    REQUIRE(static_cast<const byte*>(b) >= a + 3);
+
+    // Requests larger than the chunk size still succeed in a chunk of their own
+    const auto* big = static_cast<byte*>(arena.allocate(1024, 16));
+    REQUIRE(reinterpret_cast<std::uintptr_t>(big) % 16 == 0);
+    REQUIRE(arena.chunk_count() == 2);
+    REQUIRE(arena.bytes_used() == 3 + 8 + 1024);
+
+    auto moved = std::move(arena);
+    REQUIRE(moved.chunk_count() == 2);
+    REQUIRE(arena.chunk_count() == 0);
+
+    moved.release();
+    REQUIRE(moved.chunk_count() == 0);
+    REQUIRE(moved.bytes_used() == 0);
+}
+
+TEST_CASE("Arena boxes and vectors") {
+    Arena arena;
+
+    auto boxed = make_arena_box<u64>(arena, 42);
+    REQUIRE(*boxed == 42);
+    REQUIRE(boxed.get_deleter().arena_owned());
+    REQUIRE_FALSE(make_box<u64>(7).get_deleter().arena_owned());
+
+    // Ownership travels with the deleter when a box is converted
+    const auto converted = box_into<u64>(std::move(boxed));
+    REQUIRE(converted.get_deleter().arena_owned());
+
+    ArenaVector<u32> values{&arena};
+    for (u32 i = 0; i < 1000; ++i) { values.push_back(i); }
+    REQUIRE(values.size() == 1000);
+    REQUIRE(values.back() == 999);
+    REQUIRE(values.get_allocator().arena() == &arena);
+
+    // Without an arena the allocator falls back to the heap
+    ArenaVector<u32> heap{1, 2, 3};
+    REQUIRE(heap.get_allocator().arena() == nullptr);
+    REQUIRE(heap.size() == 3);
+}
+
+} // namespace conch::tests
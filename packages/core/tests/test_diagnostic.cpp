@@ -0,0 +1,45 @@
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "diagnostic.hpp"
+#include "source_loc.hpp"
+#include "types.hpp"
+
+namespace conch::tests {
+
+enum class TestError : u8 { FIRST, SECOND };
+
+TEST_CASE("Deferred diagnostic messages") {
+    const std::string       source{"let x"};
+    const SourceLocation    loc{1, 5};
+    const DiagnosticMessage message{"Expected {} after '{}', found {} tokens",
+                                    std::string_view{"IDENT"},
+                                    std::string_view{source}.substr(0, 3),
+                                    -2};
+
+    const Diagnostic deferred{message, TestError::FIRST, loc};
+    REQUIRE(deferred.has_msg());
+    REQUIRE(deferred.message() == "Expected IDENT after 'let', found -2 tokens");
+    REQUIRE(deferred.to_string() == "Expected IDENT after 'let', found -2 tokens (FIRST) [1, 5]");
+
+    // Deferred and eagerly formatted messages compare by their text
+    REQUIRE(deferred == Diagnostic{"Expected IDENT after 'let', found -2 tokens",
+                                   TestError::FIRST,
+                                   usize{1},
+                                   usize{5}});
+    REQUIRE(deferred != Diagnostic{message, TestError::SECOND, loc});
+    REQUIRE(deferred != Diagnostic{DiagnosticMessage{"Expected {}", 3u}, TestError::FIRST, loc});
+
+    // Characters are formatted as themselves rather than as their code
+    const DiagnosticMessage character{"Unexpected '{}' after {}", ';', 'x'};
+    REQUIRE(character.render() == "Unexpected ';' after x");
+
+    const Diagnostic bare{TestError::SECOND, usize{2}, usize{1}};
+    REQUIRE_FALSE(bare.has_msg());
+    REQUIRE_FALSE(bare.message());
+    REQUIRE(bare.to_string() == "SECOND [2, 1]");
+}
+
+} // namespace conch::tests
@@ -0,0 +1,38 @@
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "line_index.hpp"
+
+namespace conch::tests {
+
+TEST_CASE("Line index construction") {
+    REQUIRE(LineIndex{""}.line_count() == 1);
+    REQUIRE(LineIndex{"abc"}.line_count() == 1);
+
+    const LineIndex lines{"ab\n\ncd\n"};
+    REQUIRE(lines.line_count() == 4);
+    REQUIRE(lines.line_start(1) == 0);
+    REQUIRE(lines.line_start(2) == 3);
+    REQUIRE(lines.line_start(3) == 4);
+    REQUIRE(lines.line_start(4) == 7);
+}
+
+TEST_CASE("Line index locations") {
+    const std::string_view source{"ab\n\ncd\nx"};
+    const LineIndex        lines{source};
+
+    REQUIRE(lines.locate(0) == SourceLocation{1, 1});
+    REQUIRE(lines.locate(1) == SourceLocation{1, 2});
+    REQUIRE(lines.locate(4) == SourceLocation{3, 1});
+    REQUIRE(lines.locate(5) == SourceLocation{3, 2});
+    REQUIRE(lines.locate(7) == SourceLocation{4, 1});
+
+    // Newlines belong to the line they start and the end of input continues the last line
+    REQUIRE(lines.locate(2) == SourceLocation{2, 0});
+    REQUIRE(lines.locate(3) == SourceLocation{3, 0});
+    REQUIRE(lines.locate(6) == SourceLocation{4, 0});
+    REQUIRE(lines.locate(source.size()) == SourceLocation{4, 2});
+}
+
+} // namespace conch::tests
@@ -0,0 +1,43 @@
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "parallel.hpp"
+#include "types.hpp"
+
+namespace conch::tests {
+
+TEST_CASE("Fork join runs every index once") {
+    std::vector<std::atomic<usize>> calls(8);
+    parallel::fork_join(calls.size(), [&](usize i) { calls[i].fetch_add(1); });
+    for (const auto& call : calls) { REQUIRE(call.load() == 1); }
+
+    parallel::fork_join(0, [](usize) { FAIL("no work should run"); });
+}
+
+TEST_CASE("Fork join rethrows after joining") {
+    std::atomic<usize> finished{0};
+    const auto         work = [&](usize i) {
+        if (i % 2 == 1) { throw std::runtime_error{"worker failed"}; }
+        finished.fetch_add(1);
+    };
+
+    // Every worker has finished by the time the failure reaches the caller
+    REQUIRE_THROWS_AS(parallel::fork_join(6, work), std::runtime_error);
+    REQUIRE(finished.load() == 3);
+
+    // Failures on the calling thread wait for the others too
+    finished = 0;
+    REQUIRE_THROWS_AS(parallel::fork_join(4,
+                                          [&](usize i) {
+                                              if (i == 0) { throw std::bad_alloc{}; }
+                                              finished.fetch_add(1);
+                                          }),
+                      std::bad_alloc);
+    REQUIRE(finished.load() == 3);
+}
+
+} // namespace conch::tests
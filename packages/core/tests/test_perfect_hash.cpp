@@ -0,0 +1,55 @@
+#include <array>
+#include <string_view>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "perfect_hash.hpp"
+
+namespace conch::tests {
+
+using Entry = std::pair<std::string_view, int>;
+
+TEST_CASE("Perfect hash lookup") {
+    constexpr PerfectHashMap map{std::array{
+        Entry{"comptime", 0},
+        Entry{"continue", 1},
+        Entry{"const", 2},
+        Entry{"type", 3},
+        Entry{"true", 4},
+        Entry{"as", 5},
+    }};
+
+    static_assert(map.find("continue")->second == 1);
+    for (const auto& [key, value] : map.entries()) {
+        const auto found = map.find(key);
+        REQUIRE(found);
+        REQUIRE(found->first == key);
+        REQUIRE(found->second == value);
+    }
+
+    REQUIRE_FALSE(map.contains(""));
+    REQUIRE_FALSE(map.contains("a"));
+    REQUIRE_FALSE(map.contains("con"));
+    REQUIRE_FALSE(map.contains("contine"));
+    REQUIRE_FALSE(map.contains("continues"));
+    REQUIRE_FALSE(map.contains("tyre"));
+}
+
+TEST_CASE("Perfect hash with a shared prefix") {
+    constexpr PerfectHashMap map{std::array{
+        Entry{"@clz", 0},
+        Entry{"@ctz", 1},
+        Entry{"@cos", 2},
+        Entry{"@cast", 3},
+    }};
+
+    REQUIRE(map.find("@ctz")->second == 1);
+    REQUIRE(map.find("@cast")->second == 3);
+    REQUIRE_FALSE(map.contains("@"));
+    REQUIRE_FALSE(map.contains("@c"));
+    REQUIRE_FALSE(map.contains("clz"));
+    REQUIRE_FALSE(map.contains("@clzz"));
+}
+
+} // namespace conch::tests
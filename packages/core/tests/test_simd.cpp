@@ -0,0 +1,58 @@
+#include <algorithm>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simd.hpp"
+#include "simd_helpers.hpp"
+
+namespace conch::tests {
+
+TEST_CASE("Bulk whitespace skipping") {
+    for (const auto isa : helpers::supported_isas()) {
+        REQUIRE(simd::skip_whitespace("", 0, isa) == 0);
+        REQUIRE(simd::skip_whitespace("abc", 5, isa) == 3);
+        REQUIRE(simd::skip_whitespace(" \t\n\v\f\r", 0, isa) == 6);
+        REQUIRE(simd::skip_whitespace("  x  ", 0, isa) == 2);
+        REQUIRE(simd::skip_whitespace("  x  ", 3, isa) == 5);
+
+        // Sweep the first non-whitespace byte across every block boundary
+        for (usize len = 0; len < 100; ++len) {
+            std::string input(len, len % 2 == 0 ? ' ' : '\t');
+            input += "\x08\x0E!";
+            REQUIRE(simd::skip_whitespace(input, 0, isa) == len);
+        }
+    }
+}
+
+TEST_CASE("Bulk byte searching") {
+    for (const auto isa : helpers::supported_isas()) {
+        REQUIRE(simd::find_either("", 0, '\n', '\0', isa) == 0);
+        REQUIRE(simd::find_either("abc", 0, '\n', '\0', isa) == 3);
+        REQUIRE(simd::find_either("ab\ncd", 0, '\n', '\0', isa) == 2);
+        REQUIRE(simd::find_either("ab\ncd", 3, '\n', '\0', isa) == 5);
+
+        for (usize len = 0; len < 100; ++len) {
+            std::string input(len, '/');
+            input += '\n';
+            input.append(40, 'x');
+            REQUIRE(simd::find_either(input, 0, '\n', '\0', isa) == len);
+            input[len] = '\0';
+            REQUIRE(simd::find_either(input, 0, '\n', '\0', isa) == len);
+        }
+    }
+}
+
+TEST_CASE("Bulk byte counting") {
+    for (const auto isa : helpers::supported_isas()) {
+        REQUIRE(simd::count("", '\n', isa) == 0);
+        REQUIRE(simd::count("\n\n\n", '\n', isa) == 3);
+
+        std::string input;
+        for (usize i = 0; i < 300; ++i) { input += i % 7 == 0 ? '\n' : 'a'; }
+        const auto expected = static_cast<usize>(std::ranges::count(input, '\n'));
+        REQUIRE(simd::count(input, '\n', isa) == expected);
+    }
+}
+
+} // namespace conch::tests
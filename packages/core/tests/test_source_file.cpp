@@ -0,0 +1,143 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "source_file.hpp"
+
+namespace conch::tests {
+
+static auto write_temp(std::string_view name, std::string_view contents) -> std::filesystem::path {
+    const auto    path = std::filesystem::temp_directory_path() / name;
+    std::ofstream stream{path, std::ios::binary};
+    stream << contents;
+    return path;
+}
+
+// Removes a temporary file however the test using it exits.
+struct TempFileGuard {
+    std::filesystem::path path;
+
+    ~TempFileGuard() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+};
+
+TEST_CASE("Mapped source files") {
+    const std::string contents(10000, 'x');
+    const auto        path = write_temp("conch_source_file_test.conch", contents);
+
+    auto file = SourceFile::open(path);
+    REQUIRE(file);
+    REQUIRE(file->view() == contents);
+    REQUIRE(file->is_mapped());
+
+    // Moving the file must not move its contents
+    const auto data  = file->view().data();
+    auto       moved = std::move(*file);
+    REQUIRE(moved.view().data() == data);
+    REQUIRE(moved.size() == contents.size());
+    REQUIRE(file->view().empty());
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Empty and missing source files") {
+    const auto path = write_temp("conch_source_file_empty.conch", "");
+    const auto file = SourceFile::open(path);
+    REQUIRE(file);
+    REQUIRE(file->view().empty());
+    std::filesystem::remove(path);
+
+    const auto missing = SourceFile::open(path);
+    REQUIRE_FALSE(missing);
+    REQUIRE(missing.error().error() == FileError::OPEN_FAILED);
+}
+
+#if !defined(_WIN32)
+TEST_CASE("Source files too large for token offsets") {
+    // Resizing leaves the file sparse, so nothing close to its size is ever written. NTFS would
+    // allocate all of it, so this only runs where files can be sparse without asking.
+    const TempFileGuard guard{write_temp("conch_source_file_large.conch", "")};
+    std::filesystem::resize_file(guard.path, SourceFile::MAX_SIZE + 1);
+
+    const auto file = SourceFile::open(guard.path);
+    REQUIRE_FALSE(file);
+    REQUIRE(file.error().error() == FileError::TOO_LARGE);
+}
+#endif
+
+TEST_CASE("Source files with invalid UTF-8") {
+    // The overlong encoding of '/' is the first malformed sequence
+    const auto path = write_temp("conch_source_file_utf8.conch", "x := \"é\";\nvar \xc0\xaf;");
+    const auto file = SourceFile::open(path);
+    REQUIRE_FALSE(file);
+
+    const Diagnostic<FileError> expected{
+        "Invalid UTF-8 in '" + path.string() + "'", FileError::INVALID_UTF8, 2, 5};
+    REQUIRE(file.error() == expected);
+    std::filesystem::remove(path);
+}
+
+#if !defined(_WIN32)
+TEST_CASE("Source files read from a pipe") {
+    const TempFileGuard guard{std::filesystem::temp_directory_path() /
+                              "conch_source_file_fifo.conch"};
+    const auto&         path = guard.path;
+    std::filesystem::remove(path);
+    REQUIRE(::mkfifo(path.c_str(), 0600) == 0);
+
+    // The writer only sees one reader, so the pipe must be read through the descriptor it opened.
+    // Opening without blocking fails until that reader is there, so a reader that never comes
+    // lets the writer give up instead of hanging the suite. One that leaves early fails its
+    // writes rather than raising SIGPIPE.
+    const std::string contents(100000, 'p');
+    std::thread       writer{[&] {
+        sigset_t pipe_signal;
+        sigemptyset(&pipe_signal);
+        sigaddset(&pipe_signal, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &pipe_signal, nullptr);
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+        auto       fd       = ::open(path.c_str(), O_WRONLY | O_NONBLOCK);
+        while (fd < 0 && errno == ENXIO && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            fd = ::open(path.c_str(), O_WRONLY | O_NONBLOCK);
+        }
+        if (fd < 0) { return; }
+
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+        for (usize written = 0; written < contents.size();) {
+            const auto n = ::write(fd, contents.data() + written, contents.size() - written);
+            if (n < 0) { break; }
+            written += static_cast<usize>(n);
+        }
+        ::close(fd);
+    }};
+
+    const auto file = SourceFile::open(path);
+    writer.join();
+    REQUIRE(file);
+    REQUIRE_FALSE(file->is_mapped());
+    REQUIRE(file->view() == contents);
+}
+#endif
+
+} // namespace conch::tests
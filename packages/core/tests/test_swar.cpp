@@ -0,0 +1,44 @@
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "swar.hpp"
+
+namespace conch::tests {
+
+TEST_CASE("SWAR range checks") {
+    const std::string_view input{"09/:azAZ"};
+    const auto             digits = swar::in_range(swar::load(input.data()), '0', '9');
+    REQUIRE(digits == 0x0000000000008080);
+
+    const auto letters = swar::in_range(swar::load(input.data()), 'a', 'z');
+    REQUIRE(letters == 0x0000808000000000);
+}
+
+TEST_CASE("SWAR decimal decoding") {
+    REQUIRE(swar::parse_eight_decimal("00000000") == 0);
+    REQUIRE(swar::parse_eight_decimal("12345678") == 12345678);
+    REQUIRE(swar::parse_eight_decimal("99999999") == 99999999);
+    REQUIRE(swar::parse_eight_decimal("00000042") == 42);
+
+    REQUIRE_FALSE(swar::parse_eight_decimal("1234567a"));
+    REQUIRE_FALSE(swar::parse_eight_decimal("/1234567"));
+    REQUIRE_FALSE(swar::parse_eight_decimal("1234:678"));
+    REQUIRE_FALSE(swar::parse_eight_decimal("1234\xb5" "678"));
+}
+
+TEST_CASE("SWAR hex decoding") {
+    REQUIRE(swar::parse_eight_hex("00000000") == 0);
+    REQUIRE(swar::parse_eight_hex("12345678") == 0x12345678);
+    REQUIRE(swar::parse_eight_hex("deadBEEF") == 0xDEADBEEF);
+    REQUIRE(swar::parse_eight_hex("FfFfFfFf") == 0xFFFFFFFF);
+    REQUIRE(swar::parse_eight_hex("0a0B0c0D") == 0x0A0B0C0D);
+
+    REQUIRE_FALSE(swar::parse_eight_hex("1234567g"));
+    REQUIRE_FALSE(swar::parse_eight_hex("@1234567"));
+    REQUIRE_FALSE(swar::parse_eight_hex("1234`678"));
+    REQUIRE_FALSE(swar::parse_eight_hex("12 45678"));
+    REQUIRE_FALSE(swar::parse_eight_hex("\xc6" "1234567"));
+}
+
+} // namespace conch::tests
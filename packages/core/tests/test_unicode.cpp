@@ -0,0 +1,107 @@
+#include <array>
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simd.hpp"
+#include "simd_helpers.hpp"
+#include "unicode.hpp"
+
+namespace conch::tests {
+
+TEST_CASE("UTF-8 decoding") {
+    const auto decoded = [](std::string_view input) noexcept -> Optional<char32_t> {
+        const auto cp = unicode::decode(input, 0);
+        if (!cp || cp->length != input.size()) { return nullopt; }
+        return cp->value;
+    };
+
+    REQUIRE(decoded("a") == U'a');
+    REQUIRE(decoded("é") == U'é');
+    REQUIRE(decoded("月") == U'月');
+    REQUIRE(decoded("😭") == U'😭');
+    REQUIRE(decoded("\xf4\x8f\xbf\xbf") == U'\U0010FFFF');
+
+    // Stray continuations, overlong forms, surrogates, values past U+10FFFF and truncation
+    REQUIRE_FALSE(unicode::decode("\x80", 0));
+    REQUIRE_FALSE(unicode::decode("\xc0\xaf", 0));
+    REQUIRE_FALSE(unicode::decode("\xe0\x9f\xbf", 0));
+    REQUIRE_FALSE(unicode::decode("\xf0\x8f\xbf\xbf", 0));
+    REQUIRE_FALSE(unicode::decode("\xed\xa0\x80", 0));
+    REQUIRE_FALSE(unicode::decode("\xf4\x90\x80\x80", 0));
+    REQUIRE_FALSE(unicode::decode("\xf5\x80\x80\x80", 0));
+    REQUIRE_FALSE(unicode::decode("\xe6\x9c", 0));
+    REQUIRE_FALSE(unicode::decode("\xe6\x41\x88", 0));
+    REQUIRE_FALSE(unicode::decode("", 0));
+}
+
+TEST_CASE("UTF-8 validation") {
+    const auto invalid = std::to_array<std::string_view>({
+        "\x80",
+        "\xbf",
+        "\xc0\xaf",
+        "\xc1\xbf",
+        "\xc3",
+        "\xc3(",
+        "\xe0\x80\xaf",
+        "\xed\xbf\xbf",
+        "\xe6\x9c",
+        "\xf0\x80\x80\xaf",
+        "\xf4\x90\x80\x80",
+        "\xf8\x88\x80\x80\x80",
+        "\xff",
+        "\xe6\x9c\x88\x88",
+    });
+
+    for (const auto isa : helpers::supported_isas()) {
+        REQUIRE_FALSE(unicode::find_invalid_utf8("", isa));
+        REQUIRE_FALSE(unicode::find_invalid_utf8("plain ascii", isa));
+        REQUIRE_FALSE(unicode::find_invalid_utf8("月 := \"😭🎶\"; // é", isa));
+
+        // Sweep each malformed sequence across every block boundary, after valid multi-byte text
+        for (const auto bad : invalid) {
+            for (usize len = 0; len < 100; ++len) {
+                std::string input;
+                while (input.size() < len) { input += input.size() % 7 == 0 ? "é" : "x"; }
+                const auto expected = input.size();
+
+                input += bad;
+                input += "月 tail";
+                REQUIRE(unicode::find_invalid_utf8(input, isa) ==
+                        expected + (bad.starts_with("\xe6\x9c\x88") ? 3 : 0));
+            }
+        }
+
+        // Sequences cut off by the end of the input
+        for (usize len = 0; len < 70; ++len) {
+            const auto input = std::string(len, 'x') + "\xe6\x9c";
+            REQUIRE(unicode::find_invalid_utf8(input, isa) == len);
+        }
+
+        // Valid sequences straddling block boundaries
+        for (usize len = 0; len < 70; ++len) {
+            const auto input = std::string(len, 'x') + "😭月é" + std::string(len, 'y');
+            REQUIRE_FALSE(unicode::find_invalid_utf8(input, isa));
+        }
+    }
+}
+
+TEST_CASE("Identifier properties") {
+    for (const auto cp : {U'a', U'Z', U'é', U'Δ', U'月', U'ん', U'ꯍ'}) {
+        REQUIRE(unicode::is_xid_start(cp));
+        REQUIRE(unicode::is_xid_continue(cp));
+    }
+
+    for (const auto cp : {U'0', U'_', U'·', U'\u0301', U'٣'}) {
+        REQUIRE_FALSE(unicode::is_xid_start(cp));
+        REQUIRE(unicode::is_xid_continue(cp));
+    }
+
+    for (const auto cp : {U' ', U'$', U'∑', U'😭', U' ', U'\U0010FFFF', char32_t{0x110000}}) {
+        REQUIRE_FALSE(unicode::is_xid_start(cp));
+        REQUIRE_FALSE(unicode::is_xid_continue(cp));
+    }
+}
+
+} // namespace conch::tests
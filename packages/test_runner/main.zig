@@ -244,6 +244,17 @@ export fn dealloc(ptr: ?*anyopaque) callconv(.c) void {
     };
 }
 
+// Tests read the same counters as the final report to measure the allocations of a single step.
+export fn allocation_count() callconv(.c) u64 {
+    Instrumentor.once.call();
+    return instrumentor.total_nodes.load(.acquire);
+}
+
+export fn live_allocation_count() callconv(.c) u64 {
+    Instrumentor.once.call();
+    return instrumentor.node_counter.load(.acquire);
+}
+
 test "Correct allocation pipeline" {
     for ([_]usize{ 1, 4, 16, 31, 65, 1024 }) |size| {
         const nullable_ptr = alloc(size);
@@ -269,6 +280,20 @@ test "Correct allocation pipeline" {
     }
 }
 
+test "Allocation counters" {
+    const total = allocation_count();
+    const live = live_allocation_count();
+
+    const ptr = alloc(32);
+    try testing.expect(ptr != null);
+    try testing.expectEqual(total + 1, allocation_count());
+    try testing.expectEqual(live + 1, live_allocation_count());
+
+    dealloc(ptr);
+    try testing.expectEqual(total + 1, allocation_count());
+    try testing.expectEqual(live, live_allocation_count());
+}
+
 test "Detect double free" {
     const ptr = try allocImpl(32);
     dealloc(ptr);
@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""Generates packages/core/src/unicode_tables.cpp from the Unicode character database.
+
+Usage:
+    scripts/gen_unicode_tables.py DerivedCoreProperties.txt [output]
+
+DerivedCoreProperties.txt for the version named in UNICODE_VERSION can be downloaded from
+https://www.unicode.org/Public/<version>/ucd/DerivedCoreProperties.txt. The output defaults to
+the tables' place in the tree.
+"""
+
+import pathlib
+import sys
+
+UNICODE_VERSION = "14.0.0"
+
+BLOCK_SHIFT = 8
+BLOCK_SIZE = 1 << BLOCK_SHIFT
+WORD_BITS = 64
+WORDS_PER_SET = BLOCK_SIZE // WORD_BITS
+MAX_CODE_POINT = 0x10FFFF
+
+BLOCKS_PER_LINE = 16
+WORDS_PER_LINE = 4
+
+REPO_ROOT = pathlib.Path(__file__).resolve().parent.parent
+DEFAULT_OUTPUT = REPO_ROOT / "packages/core/src/unicode_tables.cpp"
+
+
+def parse_properties(path, wanted):
+    """Returns the code points carrying each wanted property."""
+    properties = {name: set() for name in wanted}
+    with open(path, encoding="utf-8") as file:
+        for line in file:
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+
+            span, name = (field.strip() for field in line.split(";")[:2])
+            if name not in properties:
+                continue
+
+            first, _, last = span.partition("..")
+            properties[name].update(range(int(first, 16), int(last or first, 16) + 1))
+    return properties
+
+
+def leaf_for(block, start, cont):
+    """Packs one block into its XID_Start bitset followed by its XID_Continue bitset."""
+    words = []
+    for members in (start, cont):
+        for word in range(WORDS_PER_SET):
+            base = (block << BLOCK_SHIFT) + word * WORD_BITS
+            bits = 0
+            for bit in range(WORD_BITS):
+                if base + bit in members:
+                    bits |= 1 << bit
+            words.append(bits)
+    return tuple(words)
+
+
+def build_tables(start, cont):
+    """Deduplicates leaves in order of first use, trimming blocks past the last set bit."""
+    last = max(max(start), max(cont))
+    block_count = (last >> BLOCK_SHIFT) + 1
+
+    leaves = {}
+    blocks = []
+    for block in range(block_count):
+        leaf = leaf_for(block, start, cont)
+        blocks.append(leaves.setdefault(leaf, len(leaves)))
+    return blocks, list(leaves)
+
+
+def render(blocks, leaves):
+    lines = [
+        "#include <array>",
+        "",
+        '#include "unicode.hpp"',
+        "",
+        "namespace conch::unicode {",
+        "",
+        "// Generated by scripts/gen_unicode_tables.py from the XID_Start and XID_Continue properties",
+        f"// of Unicode {UNICODE_VERSION}.",
+        "//",
+        "// Code points are split into blocks of 256. The first level maps each block to a leaf, and each",
+        "// leaf holds a 256 bit XID_Start bitset followed by a 256 bit XID_Continue bitset. Most blocks",
+        f"// are identical, so only {len(leaves)} distinct leaves are stored.",
+        f"constexpr usize BLOCK_SHIFT = {BLOCK_SHIFT};",
+        "",
+        "// clang-format off",
+        f"constexpr std::array<u8, {len(blocks)}> XID_BLOCKS{{",
+    ]
+
+    for i in range(0, len(blocks), BLOCKS_PER_LINE):
+        row = blocks[i : i + BLOCKS_PER_LINE]
+        lines.append("    " + ", ".join(f"{leaf:3}" for leaf in row) + ",")
+    lines += ["};", ""]
+
+    leaf_type = f"std::array<u64, {2 * WORDS_PER_SET}>"
+    lines.append(f"constexpr std::array<{leaf_type}, {len(leaves)}> XID_LEAVES{{{{")
+    for leaf in leaves:
+        rows = [
+            ", ".join(f"0x{word:016X}" for word in leaf[i : i + WORDS_PER_LINE])
+            for i in range(0, len(leaf), WORDS_PER_LINE)
+        ]
+        lines.append("    {" + ",\n     ".join(rows) + "},")
+    lines += [
+        "}};",
+        "// clang-format on",
+        "",
+        "static auto xid_bit(char32_t cp, usize word_offset) noexcept -> bool {",
+        "    const auto block = static_cast<usize>(cp) >> BLOCK_SHIFT;",
+        "    if (block >= XID_BLOCKS.size()) { return false; }",
+        "",
+        "    const auto  bit  = static_cast<usize>(cp) & ((usize{1} << BLOCK_SHIFT) - 1);",
+        "    const auto& leaf = XID_LEAVES[XID_BLOCKS[block]];",
+        "    return ((leaf[word_offset + bit / 64] >> (bit % 64)) & 1) != 0;",
+        "}",
+        "",
+        "auto is_xid_start(char32_t cp) noexcept -> bool { return xid_bit(cp, 0); }",
+        "",
+        "auto is_xid_continue(char32_t cp) noexcept -> bool "
+        f"{{ return xid_bit(cp, {WORDS_PER_SET}); }}",
+        "",
+        "} // namespace conch::unicode",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def main(argv):
+    if len(argv) not in (2, 3):
+        print(__doc__.strip(), file=sys.stderr)
+        return 1
+
+    properties = parse_properties(argv[1], ("XID_Start", "XID_Continue"))
+    start, cont = properties["XID_Start"], properties["XID_Continue"]
+    if not start or not cont or max(cont) > MAX_CODE_POINT:
+        print(f"{argv[1]} does not look like DerivedCoreProperties.txt", file=sys.stderr)
+        return 1
+
+    blocks, leaves = build_tables(start, cont)
+    if len(leaves) > 256:
+        print(f"{len(leaves)} distinct leaves do not fit in u8 indices", file=sys.stderr)
+        return 1
+
+    output = pathlib.Path(argv[2]) if len(argv) == 3 else DEFAULT_OUTPUT
+    output.write_text(render(blocks, leaves), encoding="utf-8")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))